@@ -8,9 +8,13 @@ GLOBAL _force_schedule
 
 GLOBAL interrupt_keyboardHandler
 GLOBAL irq_timer_handler
+GLOBAL interrupt_serialHandler
 GLOBAL exception_zeroDiv
 GLOBAL exception_invalidOp
 GLOBAL interrupt_systemCall
+GLOBAL interrupt_fastSystemCall
+GLOBAL interrupt_spurious
+GLOBAL interrupt_forceSchedule
 
 GLOBAL excRegData
 GLOBAL registerInfo
@@ -18,7 +22,13 @@ GLOBAL hasregisterInfo
 
 EXTERN timer_handler
 EXTERN schedule
+EXTERN schedule_yield
+EXTERN irqoff_end
+EXTERN irqtrace_cli
+EXTERN irqtrace_sti
+EXTERN apic_eoi_reg
 EXTERN keyboard_handler
+EXTERN serial_handler
 EXTERN syscall_dispatcher
 EXTERN exception_handler
 EXTERN vDriver_newline
@@ -61,9 +71,17 @@ SECTION .text
 	pop rax
 %endmacro
 
+; EOI por MMIO al LAPIC si está activo; si no, al 8259 por puerto
 %macro endOfHardwareInterrupt 0
+    mov rax, [apic_eoi_reg]
+    test rax, rax
+    jz %%pic
+    mov dword [rax], 0
+    jmp %%done
+%%pic:
     mov al, 20h
     out 20h, al
+%%done:
 %endmacro
 
 %macro saveRegistersException 0
@@ -94,21 +112,49 @@ SECTION .text
 	mov [excRegData+136], rax
 %endmacro
 
+; _cli/_sti/_hlt avisan al tracer solo cuando IF cambia de verdad
 _hlt:
+	pushfq
+	pop rax
+	test eax, 0x200
+	jnz .wait
+	sub rsp, 8              ; alinear la pila para la llamada
+	mov rdi, [rsp + 8]
+	call irqtrace_sti
+	add rsp, 8
+.wait:
 	sti
 	hlt
 	ret
 
 _cli:
+	pushfq
 	cli
+	pop rax
+	test eax, 0x200
+	jz .nested
+	mov rdi, [rsp]          ; ip: dirección de retorno de _cli
+	mov rsi, rbp            ; frame del llamador, para subir un nivel
+	jmp irqtrace_cli        ; tail call: vuelve directo al llamador
+.nested:
 	ret
 
 _sti:
+	pushfq
+	pop rax
+	test eax, 0x200
+	jnz .enabled
+	sub rsp, 8
+	mov rdi, [rsp + 8]
+	call irqtrace_sti
+	add rsp, 8
+.enabled:
 	sti
 	ret
 
+; Vector propio: pasar por el del timer contaría un tick por cada yield
 _force_schedule:
-	int 0x20
+	int 0x81
 	ret
 
 picMasterMask:
@@ -184,6 +230,36 @@ interrupt_keyboardHandler:
     popState
     iretq
 
+; COM1 (IRQ4): recepción y recarga de la FIFO de transmisión
+interrupt_serialHandler:
+	pushState
+
+	call serial_handler
+
+	endOfHardwareInterrupt
+	popState
+	iretq
+
+; Vector espurio del LAPIC (y IRQ7 espurio del 8259): no lleva EOI
+interrupt_spurious:
+	iretq
+
+; Cambio de contexto pedido por el kernel (sched_force_yield): como el
+; timer pero sin contar un tick ni mandar EOI
+interrupt_forceSchedule:
+	pushState
+
+	mov rdi, rsp
+	call schedule_yield
+
+	test rax, rax
+	jz .no_switch
+	mov rsp, rax
+
+.no_switch:
+	popState
+	iretq
+
 ; Timer interrupt handler - implements preemptive scheduling
 irq_timer_handler:
 	pushState
@@ -195,12 +271,17 @@ irq_timer_handler:
 	mov rdi, rsp
 	call schedule
 
-	; rax now contains new rsp (or 0 if no switch)
-	test rax, rax
+	; Cerrar el tramo con IF=0 que abrió timer_handler. rbx es callee-saved
+	; (y pushState ya lo guardó): conserva el rsp nuevo a través de la llamada
+	mov rbx, rax
+	call irqoff_end
+
+	; rbx now contains new rsp (or 0 if no switch)
+	test rbx, rbx
 	jz .no_switch
 
 	; Context switch: load new stack pointer
-	mov rsp, rax
+	mov rsp, rbx
 
 .no_switch:
 	endOfHardwareInterrupt
@@ -222,28 +303,31 @@ exception_invalidOp:
 	call exception_handler
 
 interrupt_systemCall:
-	; Preparar parámetros para syscall_dispatcher
-	; Sistema espera: rdi, rsi, rdx, r10, r8, r9 desde userland
-	; C ABI espera: rdi, rsi, rdx, rcx, r8, r9
-	; Necesitamos pasar 7 parámetros: rdi, rsi, rdx, r10, r8, r9, rax
-	
-	; Guardar rax (número de syscall) y r9
-	push rax
-	push r9
-	
-	; Mover r10 a rcx (4to parámetro según C ABI)
+	; Userland pasa: rdi, rsi, rdx, r10, r8, r9 y el número en rax
+	; C ABI espera: rdi, rsi, rdx, rcx, r8, r9 y el 7mo parámetro en la pila
 	mov rcx, r10
-	
-	; Restaurar r9 (6to parámetro)
-	pop r9
-	
-	; rax va como 7mo parámetro (en la pila según C ABI)
-	; Ya está en la pila desde el primer push
-	
+	push rax
 	call syscall_dispatcher
 	add rsp, 8        ; Limpiar rax de la pila
 	iretq
 
+interrupt_fastSystemCall:
+	; Entrada por SYSCALL (LSTAR): rcx = rip de retorno, r11 = rflags.
+	; SFMASK ya limpió IF, igual que la compuerta de int 0x80.
+	; Userland corre en ring 0 con el mismo stack: no hay cambio de
+	; stack y se vuelve sin SYSRET (que siempre baja a ring 3)
+	push rcx
+	push r11
+	mov rcx, r10
+	push rax          ; 7mo parámetro
+	call syscall_dispatcher
+	add rsp, 8
+	pop r11
+	pop rcx
+	push r11
+	popfq
+	jmp rcx
+
 haltcpu:
 	cli
 	hlt
@@ -0,0 +1,347 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "apic.h"
+#include "interrupts.h"
+#include "klog.h"
+#include "time.h"
+#include "infomap.h"
+
+#define MAX_IOAPICS          4
+
+// Registros del LAPIC (offsets MMIO)
+#define LAPIC_ID          0x020
+#define LAPIC_TPR         0x080
+#define LAPIC_EOI         0x0B0
+#define LAPIC_SVR         0x0F0
+#define LAPIC_LVT_TIMER   0x320
+#define LAPIC_TIMER_INIT  0x380
+#define LAPIC_TIMER_CUR   0x390
+#define LAPIC_TIMER_DIV   0x3E0
+
+#define LAPIC_SVR_ENABLE    0x100
+#define LVT_MASKED          (1u << 16)
+#define LVT_TIMER_PERIODIC  (1u << 17)
+#define LAPIC_DIV_16        0x3
+
+// IO-APIC: selección de registro y ventana de datos
+#define IOAPIC_REGSEL  0x00
+#define IOAPIC_WIN     0x10
+#define IOAPIC_VER     0x01
+#define IOAPIC_REDTBL  0x10
+
+#define REDIR_MASKED      (1u << 16)
+#define REDIR_LEVEL       (1u << 15)
+#define REDIR_ACTIVE_LOW  (1u << 13)
+
+// Los mismos vectores que tenía el 8259 remapeado
+#define VECTOR_TIMER     0x20
+#define VECTOR_KEYBOARD  0x21
+#define VECTOR_SERIAL    0x24
+
+#define ISA_IRQS          16
+#define ISA_IRQ_TIMER     0
+#define ISA_IRQ_KEYBOARD  1
+#define ISA_IRQ_SERIAL    4
+
+// Flags de un Interrupt Source Override de la MADT
+#define MPS_POLARITY_LOW  0x3
+#define MPS_TRIGGER_LEVEL 0xC
+
+// Calibración del timer del LAPIC contra el canal 2 del PIT
+#define PIT_CALIBRATE_MS     10
+#define PIT_CALIBRATE_SPINS  100000000   // tope si el canal 2 no responde
+#define PIT_PORT_CH2         0x42
+#define PIT_PORT_CMD         0x43
+#define PIT_PORT_GATE        0x61
+#define PIT_GATE_CH2         0x01
+#define PIT_SPEAKER          0x02
+#define PIT_OUT_CH2          0x20
+
+typedef struct {
+    volatile uint32_t *base;
+    uint32_t gsi_base;
+    uint32_t entries;
+} ioapic_t;
+
+typedef struct __attribute__((packed)) {
+    char signature[8];
+    uint8_t checksum;
+    char oem[6];
+    uint8_t revision;
+    uint32_t rsdt;
+    uint32_t length;
+    uint64_t xsdt;
+} rsdp_t;
+
+typedef struct __attribute__((packed)) {
+    char signature[4];
+    uint32_t length;
+    uint8_t revision;
+    uint8_t checksum;
+    char oem[6];
+    char oem_table[8];
+    uint32_t oem_revision;
+    uint32_t creator;
+    uint32_t creator_revision;
+} sdt_header_t;
+
+volatile uint32_t *apic_eoi_reg = NULL;
+
+static volatile uint32_t *lapic = NULL;
+static ioapic_t ioapics[MAX_IOAPICS];
+static int ioapic_count = 0;
+
+// GSI y flags de cada IRQ ISA; por defecto identidad, flanco, activo alto
+static uint32_t isa_gsi[ISA_IRQS];
+static uint16_t isa_flags[ISA_IRQS];
+
+static inline void outb(uint16_t port, uint8_t value);
+static inline uint8_t inb(uint16_t port);
+static uint32_t lapic_read(uint32_t reg);
+static void lapic_write(uint32_t reg, uint32_t value);
+static uint32_t ioapic_read(ioapic_t *io, uint32_t reg);
+static void ioapic_write(ioapic_t *io, uint32_t reg, uint32_t value);
+static bool sig_equals(const char *a, const char *b, int n);
+static bool checksum_ok(const void *p, uint32_t len);
+static const rsdp_t *find_rsdp(void);
+static const sdt_header_t *find_madt(void);
+static void read_overrides(void);
+static ioapic_t *ioapic_for(uint32_t gsi);
+static bool route_isa(int irq, uint8_t vector, bool masked);
+static uint64_t lapic_calibrate(void);
+
+static inline void outb(uint16_t port, uint8_t value) {
+    __asm__ volatile("outb %0, %1" : : "a"(value), "Nd"(port));
+}
+
+static inline uint8_t inb(uint16_t port) {
+    uint8_t value;
+    __asm__ volatile("inb %1, %0" : "=a"(value) : "Nd"(port));
+    return value;
+}
+
+static uint32_t lapic_read(uint32_t reg) {
+    return lapic[reg / 4];
+}
+
+static void lapic_write(uint32_t reg, uint32_t value) {
+    lapic[reg / 4] = value;
+}
+
+static uint32_t ioapic_read(ioapic_t *io, uint32_t reg) {
+    io->base[IOAPIC_REGSEL / 4] = reg;
+    return io->base[IOAPIC_WIN / 4];
+}
+
+static void ioapic_write(ioapic_t *io, uint32_t reg, uint32_t value) {
+    io->base[IOAPIC_REGSEL / 4] = reg;
+    io->base[IOAPIC_WIN / 4] = value;
+}
+
+static bool sig_equals(const char *a, const char *b, int n) {
+    for (int i = 0; i < n; i++) {
+        if (a[i] != b[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool checksum_ok(const void *p, uint32_t len) {
+    const uint8_t *bytes = (const uint8_t *)p;
+    uint8_t sum = 0;
+    for (uint32_t i = 0; i < len; i++) {
+        sum += bytes[i];
+    }
+    return sum == 0;
+}
+
+// La RSDP está en el primer KB de la EBDA o entre 0xE0000 y 0xFFFFF,
+// alineada a 16 bytes
+static const rsdp_t *find_rsdp(void) {
+    uintptr_t ebda = (uintptr_t)(*(volatile uint16_t *)0x40E) << 4;
+    uintptr_t ranges[2][2] = {{ebda, ebda + 1024}, {0xE0000, 0x100000}};
+
+    for (int r = 0; r < 2; r++) {
+        if (ranges[r][0] == 0) {
+            continue;
+        }
+        for (uintptr_t p = ranges[r][0]; p + sizeof(rsdp_t) <= ranges[r][1]; p += 16) {
+            const rsdp_t *rsdp = (const rsdp_t *)p;
+            if (sig_equals(rsdp->signature, "RSD PTR ", 8) && checksum_ok(rsdp, 20)) {
+                return rsdp;
+            }
+        }
+    }
+    return NULL;
+}
+
+static const sdt_header_t *find_madt(void) {
+    const rsdp_t *rsdp = find_rsdp();
+    if (rsdp == NULL) {
+        return NULL;
+    }
+
+    bool xsdt = rsdp->revision >= 2 && rsdp->xsdt != 0;
+    const sdt_header_t *root = xsdt ? (const sdt_header_t *)(uintptr_t)rsdp->xsdt
+                                    : (const sdt_header_t *)(uintptr_t)rsdp->rsdt;
+    uint32_t entry_size = xsdt ? 8 : 4;
+    uint32_t count = (root->length - sizeof(sdt_header_t)) / entry_size;
+    const uint8_t *entries = (const uint8_t *)root + sizeof(sdt_header_t);
+
+    for (uint32_t i = 0; i < count; i++) {
+        uintptr_t addr = xsdt ? (uintptr_t)((const uint64_t *)entries)[i]
+                              : (uintptr_t)((const uint32_t *)entries)[i];
+        const sdt_header_t *table = (const sdt_header_t *)addr;
+        if (table != NULL && sig_equals(table->signature, "APIC", 4)) {
+            return table;
+        }
+    }
+    return NULL;
+}
+
+// Pure64 lee los Interrupt Source Overrides pero no los guarda: se buscan
+// en la MADT. Típicamente el PIT (IRQ0) llega por el GSI 2
+static void read_overrides(void) {
+    for (int i = 0; i < ISA_IRQS; i++) {
+        isa_gsi[i] = i;
+        isa_flags[i] = 0;
+    }
+
+    const sdt_header_t *madt = find_madt();
+    if (madt == NULL) {
+        return;
+    }
+
+    const uint8_t *p = (const uint8_t *)madt + sizeof(sdt_header_t) + 8;
+    const uint8_t *end = (const uint8_t *)madt + madt->length;
+    while (p + 2 <= end && p[1] >= 2) {
+        if (p[0] == 2 && p[1] >= 10 && p[3] < ISA_IRQS) {
+            isa_gsi[p[3]] = *(const uint32_t *)(p + 4);
+            isa_flags[p[3]] = *(const uint16_t *)(p + 8);
+        }
+        p += p[1];
+    }
+}
+
+static ioapic_t *ioapic_for(uint32_t gsi) {
+    for (int i = 0; i < ioapic_count; i++) {
+        if (gsi >= ioapics[i].gsi_base && gsi < ioapics[i].gsi_base + ioapics[i].entries) {
+            return &ioapics[i];
+        }
+    }
+    return NULL;
+}
+
+// Entrega física al LAPIC de este CPU
+static bool route_isa(int irq, uint8_t vector, bool masked) {
+    uint32_t gsi = isa_gsi[irq];
+    ioapic_t *io = ioapic_for(gsi);
+    if (io == NULL) {
+        return false;
+    }
+
+    uint32_t low = vector;
+    if ((isa_flags[irq] & MPS_POLARITY_LOW) == MPS_POLARITY_LOW) {
+        low |= REDIR_ACTIVE_LOW;
+    }
+    if ((isa_flags[irq] & MPS_TRIGGER_LEVEL) == MPS_TRIGGER_LEVEL) {
+        low |= REDIR_LEVEL;
+    }
+    if (masked) {
+        low |= REDIR_MASKED;
+    }
+
+    uint32_t reg = IOAPIC_REDTBL + 2 * (gsi - io->gsi_base);
+    ioapic_write(io, reg + 1, lapic_read(LAPIC_ID) & 0xFF000000);
+    ioapic_write(io, reg, low);
+    return true;
+}
+
+// Cuenta cuánto avanza el timer del LAPIC (divisor 16) mientras el canal 2
+// del PIT, con el parlante apagado, cuenta PIT_CALIBRATE_MS. Devuelve
+// cuentas por segundo, o 0 si el PIT no terminó
+static uint64_t lapic_calibrate(void) {
+    uint8_t gate = inb(PIT_PORT_GATE) & ~(PIT_GATE_CH2 | PIT_SPEAKER);
+    uint16_t count = PIT_HZ / (1000 / PIT_CALIBRATE_MS);
+
+    outb(PIT_PORT_GATE, gate);
+    outb(PIT_PORT_CMD, 0xB0);   // canal 2, lo/hi, modo 0
+    outb(PIT_PORT_CH2, count & 0xFF);
+    outb(PIT_PORT_CH2, count >> 8);
+
+    lapic_write(LAPIC_TIMER_DIV, LAPIC_DIV_16);
+    lapic_write(LAPIC_LVT_TIMER, LVT_MASKED);
+
+    outb(PIT_PORT_GATE, gate | PIT_GATE_CH2);   // arranca la cuenta
+    lapic_write(LAPIC_TIMER_INIT, 0xFFFFFFFF);
+
+    uint32_t spins = 0;
+    while (!(inb(PIT_PORT_GATE) & PIT_OUT_CH2) && ++spins < PIT_CALIBRATE_SPINS) {
+    }
+    uint32_t elapsed = 0xFFFFFFFF - lapic_read(LAPIC_TIMER_CUR);
+
+    lapic_write(LAPIC_TIMER_INIT, 0);
+    outb(PIT_PORT_GATE, gate);
+
+    if (spins >= PIT_CALIBRATE_SPINS) {
+        return 0;
+    }
+    return (uint64_t)elapsed * (1000 / PIT_CALIBRATE_MS);
+}
+
+bool apic_init(void) {
+    uint64_t lapic_addr = *(volatile uint64_t *)INFOMAP_LAPIC_ADDR;
+    int count = *(volatile uint8_t *)INFOMAP_IOAPIC_COUNT;
+    if (lapic_addr == 0 || count == 0) {
+        printk(KLOG_INFO, "apic: not found, using the 8259");
+        return false;
+    }
+
+    if (count > MAX_IOAPICS) {
+        count = MAX_IOAPICS;
+    }
+    const volatile uint32_t *list = (const volatile uint32_t *)INFOMAP_IOAPIC_LIST;
+    for (int i = 0; i < count; i++) {
+        ioapic_t *io = &ioapics[i];
+        io->base = (volatile uint32_t *)(uintptr_t)list[2 * i];
+        io->gsi_base = list[2 * i + 1];
+        io->entries = ((ioapic_read(io, IOAPIC_VER) >> 16) & 0xFF) + 1;
+        for (uint32_t e = 0; e < io->entries; e++) {
+            ioapic_write(io, IOAPIC_REDTBL + 2 * e, REDIR_MASKED);
+        }
+    }
+    ioapic_count = count;
+    lapic = (volatile uint32_t *)(uintptr_t)lapic_addr;
+    read_overrides();
+
+    // Desde acá el 8259 no entrega nada
+    picMasterMask(0xFF);
+    picSlaveMask(0xFF);
+
+    lapic_write(LAPIC_TPR, 0);
+    lapic_write(LAPIC_SVR, LAPIC_SVR_ENABLE | APIC_SPURIOUS_VECTOR);
+
+    route_isa(ISA_IRQ_KEYBOARD, VECTOR_KEYBOARD, false);
+    route_isa(ISA_IRQ_SERIAL, VECTOR_SERIAL, false);
+
+    uint64_t freq = lapic_calibrate();
+    if (freq != 0) {
+        uint32_t initial = (uint32_t)((freq + TICK_HZ / 2) / TICK_HZ);
+        lapic_write(LAPIC_TIMER_DIV, LAPIC_DIV_16);
+        lapic_write(LAPIC_LVT_TIMER, LVT_TIMER_PERIODIC | VECTOR_TIMER);
+        lapic_write(LAPIC_TIMER_INIT, initial);
+        route_isa(ISA_IRQ_TIMER, VECTOR_TIMER, true);
+    } else {
+        route_isa(ISA_IRQ_TIMER, VECTOR_TIMER, false);
+    }
+
+    apic_eoi_reg = &lapic[LAPIC_EOI / 4];
+    printk(KLOG_INFO, "apic: lapic %p, %d ioapic(s), %d Hz tick from the %s (%lu Hz bus/16)",
+           (void *)lapic, ioapic_count, TICK_HZ, freq != 0 ? "lapic" : "pit", freq);
+    return true;
+}
+
+bool apic_enabled(void) {
+    return apic_eoi_reg != NULL;
+}
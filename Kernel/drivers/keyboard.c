@@ -2,6 +2,8 @@
 #include "keyboard.h"
 #include "time.h"
 #include <tty.h>
+#include <irqoff.h>
+#include <irqtrace.h>
 #include <stdint.h>
 
 unsigned char notChar = 0;
@@ -10,6 +12,8 @@ static int shift = 0;
 static int capsLock = 0;
 static int ctrl = 0;
 
+static irqoff_site_t keyboard_site = IRQOFF_SITE("irq:keyboard", IRQOFF_IRQ);
+
 static const char keyMapL[] = {
 
     0,
@@ -147,6 +151,8 @@ static const char *const keyMap[] = {keyMapL, keyMapU};
 // Interrupción de teclado: actualiza modificadores y entrega el ASCII a la TTY
 void keyboard_handler(uint8_t keyPressed)
 {
+    irqtrace_kbd_entry();
+    irqoff_begin(&keyboard_site);
     notChar = keyPressed;
 
     // shift pressed
@@ -180,6 +186,7 @@ void keyboard_handler(uint8_t keyPressed)
     {
         tty_handle_input(notChar, ascii);
     }
+    irqoff_end();
 }
 
 // Traduce el scancode actual a ASCII (considerando Shift/Caps y Ctrl)
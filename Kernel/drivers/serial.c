@@ -0,0 +1,287 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <serial.h>
+#include <klog.h>
+#include "sched.h"
+#include "spinlock.h"
+#include "wait_queue.h"
+#include "poll.h"
+#include "errno.h"
+#include "irqoff.h"
+
+#define COM1_PORT 0x3F8
+
+#define UART_DATA 0   // RBR/THR (DLL con DLAB)
+#define UART_IER  1   // (DLM con DLAB)
+#define UART_IIR  2   // lectura: identificación; escritura: FCR
+#define UART_LCR  3
+#define UART_MCR  4
+#define UART_LSR  5
+#define UART_SCR  7
+
+#define IER_RX    0x01
+#define IER_THRE  0x02
+#define LSR_DATA  0x01
+#define LSR_THRE  0x20
+#define IIR_NONE  0x01
+
+#define UART_FIFO_SIZE  16
+#define SERIAL_TX_SIZE  4096   // potencias de 2
+#define SERIAL_RX_SIZE  256
+
+typedef struct {
+    uint8_t *buf;
+    uint32_t size;
+    uint32_t head;   // próximo a sacar
+    uint32_t count;
+} serial_ring_t;
+
+static uint8_t tx_storage[SERIAL_TX_SIZE];
+static uint8_t rx_storage[SERIAL_RX_SIZE];
+static serial_ring_t tx = {tx_storage, SERIAL_TX_SIZE, 0, 0};
+static serial_ring_t rx = {rx_storage, SERIAL_RX_SIZE, 0, 0};
+
+static spinlock_t serial_lock;
+static wait_queue_t tx_waiters;
+static wait_queue_t rx_waiters;
+static wait_queue_t pollers;
+static bool present = false;
+static bool thre_enabled = false;
+
+static irqoff_site_t serial_site = IRQOFF_SITE("irq:serial", IRQOFF_IRQ);
+
+static inline void outb(uint16_t port, uint8_t value);
+static inline uint8_t inb(uint16_t port);
+static uint32_t ring_put(serial_ring_t *r, const uint8_t *src, uint32_t n);
+static uint32_t ring_get(serial_ring_t *r, uint8_t *dst, uint32_t n);
+static void tx_kick(void);
+static int block_on(wait_queue_t *q, serial_ring_t *r, bool want_space);
+static void log_sink(const char *line, int len);
+
+static inline void outb(uint16_t port, uint8_t value) {
+    __asm__ volatile("outb %0, %1" : : "a"(value), "Nd"(port));
+}
+
+static inline uint8_t inb(uint16_t port) {
+    uint8_t value;
+    __asm__ volatile("inb %1, %0" : "=a"(value) : "Nd"(port));
+    return value;
+}
+
+static uint32_t ring_put(serial_ring_t *r, const uint8_t *src, uint32_t n) {
+    uint32_t done = 0;
+    while (done < n && r->count < r->size) {
+        r->buf[(r->head + r->count) & (r->size - 1)] = src[done++];
+        r->count++;
+    }
+    return done;
+}
+
+static uint32_t ring_get(serial_ring_t *r, uint8_t *dst, uint32_t n) {
+    uint32_t done = 0;
+    while (done < n && r->count > 0) {
+        dst[done++] = r->buf[r->head];
+        r->head = (r->head + 1) & (r->size - 1);
+        r->count--;
+    }
+    return done;
+}
+
+// Carga la FIFO del UART desde el ring; con el lock tomado. Mientras quede
+// algo en el ring la interrupción THRE sigue habilitada para continuar
+static void tx_kick(void) {
+    if (inb(COM1_PORT + UART_LSR) & LSR_THRE) {
+        uint8_t chunk[UART_FIFO_SIZE];
+        uint32_t n = ring_get(&tx, chunk, UART_FIFO_SIZE);
+        for (uint32_t i = 0; i < n; i++) {
+            outb(COM1_PORT + UART_DATA, chunk[i]);
+        }
+    }
+
+    bool want = tx.count > 0;
+    if (want != thre_enabled) {
+        thre_enabled = want;
+        outb(COM1_PORT + UART_IER, IER_RX | (want ? IER_THRE : 0));
+    }
+}
+
+void serial_init(void) {
+    spinlock_init(&serial_lock);
+    wait_queue_init(&tx_waiters, &serial_lock);
+    wait_queue_init(&rx_waiters, &serial_lock);
+    wait_queue_init(&pollers, &serial_lock);
+
+    // Sin UART el registro scratch no retiene lo escrito
+    outb(COM1_PORT + UART_SCR, 0xA5);
+    if (inb(COM1_PORT + UART_SCR) != 0xA5) {
+        return;
+    }
+
+    outb(COM1_PORT + UART_IER, 0x00);
+    outb(COM1_PORT + UART_LCR, 0x80);   // DLAB: divisor 1 = 115200 baudios
+    outb(COM1_PORT + UART_DATA, 0x01);
+    outb(COM1_PORT + UART_IER, 0x00);
+    outb(COM1_PORT + UART_LCR, 0x03);   // 8N1
+    outb(COM1_PORT + UART_IIR, 0xC7);   // FIFOs habilitadas y limpias
+
+    // Prueba en loopback antes de declarar el puerto usable
+    outb(COM1_PORT + UART_MCR, 0x1E);
+    outb(COM1_PORT + UART_DATA, 0xAE);
+    if (inb(COM1_PORT + UART_DATA) != 0xAE) {
+        return;
+    }
+
+    outb(COM1_PORT + UART_MCR, 0x0B);   // DTR, RTS y OUT2 (habilita la IRQ)
+    outb(COM1_PORT + UART_IER, IER_RX);
+    present = true;
+
+    klog_set_sink(log_sink);
+    printk(KLOG_INFO, "serial: COM1 at 115200 8N1");
+}
+
+bool serial_present(void) {
+    return present;
+}
+
+// IRQ4: vacía la recepción y recarga la FIFO de transmisión
+void serial_handler(void) {
+    if (!present) {
+        return;
+    }
+
+    irqoff_begin(&serial_site);
+    spinlock_lock(&serial_lock);
+    bool rx_ready = false;
+    bool tx_space = false;
+
+    while ((inb(COM1_PORT + UART_IIR) & IIR_NONE) == 0) {
+        while (inb(COM1_PORT + UART_LSR) & LSR_DATA) {
+            uint8_t c = inb(COM1_PORT + UART_DATA);
+            rx_ready |= ring_put(&rx, &c, 1) > 0;
+        }
+        uint32_t before = tx.count;
+        tx_kick();
+        tx_space |= tx.count < before;
+        if (!thre_enabled && !(inb(COM1_PORT + UART_LSR) & LSR_DATA)) {
+            break;
+        }
+    }
+
+    if (rx_ready) {
+        wait_queue_wake_all(&rx_waiters);
+    }
+    if (tx_space) {
+        wait_queue_wake_all(&tx_waiters);
+    }
+    if (rx_ready || tx_space) {
+        wait_queue_wake_all(&pollers);
+    }
+    spinlock_unlock(&serial_lock);
+    irqoff_end();
+}
+
+// Bloquea hasta que haya lugar (want_space) o datos en el ring. Se encola
+// antes de re-verificar para no perder el wakeup de la interrupción
+static int block_on(wait_queue_t *q, serial_ring_t *r, bool want_space) {
+    pcb_t *current = sched_current();
+    if (current == NULL) {
+        return -1;
+    }
+
+    uint64_t flags = spinlock_lock_irqsave(&serial_lock);
+    if (want_space ? r->count < r->size : r->count > 0) {
+        spinlock_unlock_irqrestore(&serial_lock, flags);
+        return 0;
+    }
+    wait_queue_add(q, &current->wait_node, current);
+    current->state = BLOCKED;
+    current->ticks_left = 0;
+    spinlock_unlock_irqrestore(&serial_lock, flags);
+
+    sched_force_yield();
+    return 0;
+}
+
+int serial_write(const void *buf, int n, bool nonblock) {
+    if (!present) {
+        return E_IO;
+    }
+    if (buf == NULL || n <= 0) {
+        return E_INVAL;
+    }
+
+    const uint8_t *src = (const uint8_t *)buf;
+    int written = 0;
+    while (written < n) {
+        uint64_t flags = spinlock_lock_irqsave(&serial_lock);
+        written += (int)ring_put(&tx, src + written, (uint32_t)(n - written));
+        tx_kick();
+        spinlock_unlock_irqrestore(&serial_lock, flags);
+
+        if (written < n) {
+            if (nonblock) {
+                return written > 0 ? written : E_AGAIN;
+            }
+            if (block_on(&tx_waiters, &tx, true) < 0) {
+                return written > 0 ? written : -1;
+            }
+        }
+    }
+    return written;
+}
+
+int serial_read(void *buf, int n, bool nonblock) {
+    if (!present) {
+        return E_IO;
+    }
+    if (buf == NULL || n <= 0) {
+        return E_INVAL;
+    }
+
+    while (1) {
+        uint64_t flags = spinlock_lock_irqsave(&serial_lock);
+        int got = (int)ring_get(&rx, (uint8_t *)buf, (uint32_t)n);
+        spinlock_unlock_irqrestore(&serial_lock, flags);
+
+        if (got > 0) {
+            return got;
+        }
+        if (nonblock) {
+            return E_AGAIN;
+        }
+        if (block_on(&rx_waiters, &rx, false) < 0) {
+            return -1;
+        }
+    }
+}
+
+int serial_poll(struct wait_node *w) {
+    if (!present) {
+        return POLLERR;
+    }
+
+    uint64_t flags = spinlock_lock_irqsave(&serial_lock);
+    if (w != NULL) {
+        wait_queue_add(&pollers, w, sched_current());
+    }
+    int mask = 0;
+    if (rx.count > 0) {
+        mask |= POLLIN;
+    }
+    if (tx.count < tx.size) {
+        mask |= POLLOUT;
+    }
+    spinlock_unlock_irqrestore(&serial_lock, flags);
+    return mask;
+}
+
+// Sink del log del kernel: nunca bloquea (printk puede venir de una IRQ);
+// si el ring está lleno la línea se descarta entera (sigue en dmesg)
+static void log_sink(const char *line, int len) {
+    uint64_t flags = spinlock_lock_irqsave(&serial_lock);
+    if (tx.size - tx.count >= (uint32_t)len) {
+        ring_put(&tx, (const uint8_t *)line, (uint32_t)len);
+        tx_kick();
+    }
+    spinlock_unlock_irqrestore(&serial_lock, flags);
+}
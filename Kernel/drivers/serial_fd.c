@@ -0,0 +1,40 @@
+#include <stddef.h>
+#include "fd.h"
+#include "serial.h"
+#include "poll.h"
+
+// Adaptador para exponer COM1 como file descriptor (FD_SERIAL)
+
+static int fd_serial_read(file_t *file, void *buf, int n) {
+    if (file == NULL || !file->can_read) {
+        return -1;
+    }
+    return serial_read(buf, n, (file->flags & O_NONBLOCK) != 0);
+}
+
+static int fd_serial_write(file_t *file, const void *buf, int n) {
+    if (file == NULL || !file->can_write) {
+        return -1;
+    }
+    return serial_write(buf, n, (file->flags & O_NONBLOCK) != 0);
+}
+
+// El puerto es único y vive lo que el kernel: cerrar no libera nada
+static int fd_serial_close(file_t *file) {
+    (void)file;
+    return 0;
+}
+
+static int fd_serial_poll(file_t *file, struct wait_node *w) {
+    if (file == NULL) {
+        return POLLNVAL;
+    }
+    return serial_poll(w);
+}
+
+const struct fd_ops SERIAL_OPS = {
+    .read = fd_serial_read,
+    .write = fd_serial_write,
+    .close = fd_serial_close,
+    .poll = fd_serial_poll
+};
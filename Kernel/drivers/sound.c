@@ -1,11 +1,48 @@
 #include <stdint.h>
+#include <stddef.h>
 #include <time.h>
 #include <sound.h>
+#include <interrupts.h>
 
 
 uint8_t spkIn(uint16_t port);
 void spkOut(uint16_t port, uint8_t value);
 
+// Cola de notas que el timer va reproduciendo: quien envía una melodía
+// no queda bloqueado mientras suena
+#define SOUND_QUEUE_LEN 64
+
+typedef struct {
+    uint32_t freq;
+    uint64_t ticks;
+} queued_note_t;
+
+static queued_note_t noteQueue[SOUND_QUEUE_LEN];
+static int queueHead = 0;
+static int queueCount = 0;
+static uint64_t noteTicksLeft = 0;  // ticks restantes de la nota que suena
+static int playing = 0;
+
+static uint64_t irq_save(void);
+static void irq_restore(uint64_t flags);
+static void startNextNote(void);
+
+static uint64_t irq_save(void)
+{
+    uint64_t flags;
+    __asm__ volatile("pushfq\n\tpop %0" : "=r"(flags));
+    _cli();
+    return flags;
+}
+
+static void irq_restore(uint64_t flags)
+{
+    if (flags & (1ULL << 9))
+    {
+        _sti();
+    }
+}
+
 void stopSpeaker()
 {
     uint8_t tmp = spkIn(0x61) & 0xFC;
@@ -42,4 +79,79 @@ void beep(uint32_t freq, uint64_t duration)
     triggerSpeaker(freq);
     sleep(duration);
     stopSpeaker();
-}
\ No newline at end of file
+}
+
+// Saca la próxima nota de la cola y la hace sonar (frecuencia 0 = silencio)
+static void startNextNote(void)
+{
+    if (queueCount == 0)
+    {
+        stopSpeaker();
+        playing = 0;
+        return;
+    }
+
+    queued_note_t *note = &noteQueue[queueHead];
+    queueHead = (queueHead + 1) % SOUND_QUEUE_LEN;
+    queueCount--;
+
+    triggerSpeaker(note->freq);
+    noteTicksLeft = note->ticks;
+    playing = 1;
+}
+
+// Encola hasta llenar la cola; devuelve cuántas notas se aceptaron
+int sound_enqueue(const sound_note_t *notes, int count)
+{
+    if (notes == NULL || count < 0)
+    {
+        return -1;
+    }
+
+    uint64_t flags = irq_save();
+    int accepted = 0;
+    while (accepted < count && queueCount < SOUND_QUEUE_LEN)
+    {
+        int tail = (queueHead + queueCount) % SOUND_QUEUE_LEN;
+        uint64_t ticks = ms_to_ticks(notes[accepted].duration);
+        noteQueue[tail].freq = notes[accepted].freq > 0 ? (uint32_t)notes[accepted].freq : 0;
+        noteQueue[tail].ticks = ticks > 0 ? ticks : 1;
+        queueCount++;
+        accepted++;
+    }
+    if (!playing)
+    {
+        startNextNote();
+    }
+    irq_restore(flags);
+
+    return accepted;
+}
+
+// Descarta la melodía en curso y las notas pendientes
+void sound_cancel(void)
+{
+    uint64_t flags = irq_save();
+    queueCount = 0;
+    noteTicksLeft = 0;
+    playing = 0;
+    stopSpeaker();
+    irq_restore(flags);
+}
+
+// Llamado en cada tick del timer con interrupciones deshabilitadas
+void sound_tick(void)
+{
+    if (!playing)
+    {
+        return;
+    }
+    if (noteTicksLeft > 0)
+    {
+        noteTicksLeft--;
+    }
+    if (noteTicksLeft == 0)
+    {
+        startNextNote();
+    }
+}
@@ -1,6 +1,9 @@
+#include <stddef.h>
 #include "videoDriver.h"
 #include "font.h"
 #include "time.h"
+#include "lib.h"
+#include "infomap.h"
 
 
 Color WHITE = {255,255,255};
@@ -57,14 +60,55 @@ static void scrollUp ();
 static uint32_t uintToBase(uint64_t value, char * buffer, uint32_t base);
 /* Gets the pixel pointer in screen from the (x,y) coordinate*/
 static uint32_t* getPixelPtr(uint16_t x, uint16_t y);
+/* blits a whole glyph at (x,y) using the pre-expanded row spans */
+static void blitGlyph(uint16_t x, uint16_t y, unsigned char c, Color fntColor, Color bgColor);
+/* discards the pre-expanded spans (scale or colours changed) */
+static void glyphCacheInvalidate(void);
+/* returns the cached span for a 4-bit glyph row half, expanding it if needed */
+static const uint8_t *nibbleSpan(uint8_t nibble, uint8_t pixelBytes);
+static int sameColor(Color a, Color b);
+/* paints `count` full rows starting at y with a solid colour */
+static void fillRows(uint32_t y, uint32_t count, Color color);
+/* records that a rectangle of the back buffer changed */
+static void markDirty(uint32_t x, uint32_t y, uint32_t w, uint32_t h);
+
+#define MAX_SCALE 5
+#define MAX_PIXEL_BYTES 4
+#define NIBBLE_SPAN_MAX (4 * MAX_SCALE * MAX_PIXEL_BYTES)
+
+// Cache de spans pre-expandidos: cada fila de un glyph son 8 bits, que se
+// dibujan como dos mitades de 4 bits. Para cada valor de nibble guardamos
+// los 4*pixelScale píxeles ya convertidos al formato del framebuffer con los
+// colores actuales, así una fila se copia con dos memcpy en vez de píxel a píxel
+static uint8_t nibbleSpans[16][NIBBLE_SPAN_MAX];
+static uint16_t nibbleValid = 0;   // bit n = span del nibble n calculado
+static Color spanFnt;
+static Color spanBg;
+
+// Back buffer en RAM: todo se dibuja acá y vDriver_flush copia al framebuffer
+// solo el tramo sucio de cada fila. Ocupa una región física libre (identity
+// mapped) por encima del heap y de los módulos; solo se usa si hay RAM ahí
+#define BACK_BUFFER_ADDR     0x1000000
+#define BACK_BUFFER_MAX      (16 * 1024 * 1024)
+#define MAX_SCREEN_ROWS      1200
+#define BATCH_TIMEOUT_MS     500    // un batch abandonado no congela la pantalla
+
+static uint8_t *backBuffer = NULL;          // NULL = se dibuja directo al framebuffer
+static uint16_t dirtyLo[MAX_SCREEN_ROWS];   // primera columna sucia de la fila
+static uint16_t dirtyHi[MAX_SCREEN_ROWS];   // columna siguiente a la última (0 = limpia)
+static uint32_t dirtyTop = 0;               // filas con algo sucio: [dirtyTop, dirtyBottom)
+static uint32_t dirtyBottom = 0;
+static int batchDepth = 0;
+static uint64_t batchStart = 0;
 
 // Establecer un factor de escala predeterminado
 uint8_t pixelScale = 1;
 
 // Aumentar el factor de escala para aumentar el tamaño de un carácter
 void plusScale() {
-    if (pixelScale < 5) {
+    if (pixelScale < MAX_SCALE) {
         pixelScale++;
+        glyphCacheInvalidate();
     }
 }
 
@@ -72,6 +116,7 @@ void plusScale() {
 void minusScale() {
     if (pixelScale > 1) {
         pixelScale--;
+        glyphCacheInvalidate();
     }
 }
 
@@ -101,6 +146,13 @@ void vDriver_prints(const char *str, Color fnt, Color bgd){
     }
 }
 
+// Escribe n caracteres (no necesita terminador) con los mismos colores
+void vDriver_write(const char *str, int n, Color fnt, Color bgd){
+    for (int i = 0; i < n; i++){
+        vDriver_print(str[i], fnt, bgd);
+    }
+}
+
 void vDriver_print(const char c, Color fnt, Color bgd){
     switch (c) {
         case '\n':
@@ -139,20 +191,9 @@ void vDriver_backspace(Color fnt, Color bgd){
 }
 
 void vDriver_drawCursor(){
-    int cx, cy;
-    Color fntColor = cursorOn ? BLACK : WHITE;
-    Color bgColor = cursorOn ? BLACK : WHITE;
-    //mascara de bits para saber que color imprimo a pantalla, si pertenece a caracter o a fondo
-    int mask[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
-
-    const unsigned char *glyph;
-    if (cursorOn){
-        glyph = font_bitmap + 16 * (' ' - 32);
-        cursorOn = 0;
-    } else {
-        glyph = font_bitmap + 16 * (' ' - 32);
-        cursorOn = 1;
-    }
+    // El cursor es una celda llena: un espacio con fondo del mismo color
+    Color color = cursorOn ? BLACK : WHITE;
+    cursorOn = !cursorOn;
 
 // Chequeo que no sea el final de línea, ni el final de la pantalla
     if (cursorX >= screenInfo->width) {
@@ -165,27 +206,11 @@ void vDriver_drawCursor(){
         }
     }
 
-    for (cy = 0; cy < 16; cy++) {
-        for (cx = 0; cx < 8; cx++) {
-            // Uso el factor de escala
-            for (int i = 0; i < pixelScale; i++) {
-                for (int j = 0; j < pixelScale; j++) {
-                    vDriver_setPixel(cursorX + (8 - cx) * pixelScale + i, cursorY + cy * pixelScale + j, glyph[cy] & mask[cx] ? fntColor : bgColor);
-                }
-            }
-        }
-    }
-
+    blitGlyph(cursorX, cursorY, ' ', color, color);
 }
 
 void vDriver_clear() {
-    Color color = BLACK;
-    Color* pixel = (Color*) ((uint64_t)screenInfo->framebuffer);
-
-    //recorro todos los pixeles de la pantalla y los pongo del color que quiero
-    for (uint32_t len = (uint32_t)screenInfo->width * screenInfo->height; len; len--, pixel++){
-        *pixel = color;
-    }
+    fillRows(0, screenInfo->height, BLACK);
 
     //seteo los cursores en el inicio (arriba a la izquierda)
     cursorX = 0;
@@ -195,13 +220,6 @@ void vDriver_clear() {
 static void drawChar(int x, int y, unsigned char c, Color fntColor, Color bgColor) {
     (void)x;
     (void)y;
-    //con estos indices recorro el caracter
-    int cx, cy;
-    //mascara de bits para saber que color imprimo a pantalla, si pertenece a caracter o a fondo
-    int mask[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
-    //puntero a donde inician los datos de mi caracter, hago (c-32 pues los caracteres imprimibles arrancan en el 32), lo multiplico por 16 pues es lo que ocupa
-    //un caracter en el bitmap
-    const unsigned char *glyph = font_bitmap + 16 * (c - 32);
 
     // Chequeo que no sea el final de línea, ni el final de la pantalla
     if (cursorX >= screenInfo->width) {
@@ -214,29 +232,151 @@ static void drawChar(int x, int y, unsigned char c, Color fntColor, Color bgColo
         }
     }
 
-    for (cy = 0; cy < 16; cy++) {
-        for (cx = 0; cx < 8; cx++) {
-            // Uso el factor de escala
-            for (int i = 0; i < pixelScale; i++) {
-                for (int j = 0; j < pixelScale; j++) {
-                    vDriver_setPixel(cursorX + (8 - cx) * pixelScale + i, cursorY + cy * pixelScale + j, glyph[cy] & mask[cx] ? fntColor : bgColor);
-                }
+    blitGlyph(cursorX, cursorY, c, fntColor, bgColor);
+
+    cursorX += getRealCharWidth();
+}
+
+static void glyphCacheInvalidate(void) {
+    nibbleValid = 0;
+}
+
+static int sameColor(Color a, Color b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+// Expande un nibble a 4*pixelScale píxeles; el bit más alto va a la izquierda
+static const uint8_t *nibbleSpan(uint8_t nibble, uint8_t pixelBytes) {
+    uint8_t *span = nibbleSpans[nibble];
+    if (nibbleValid & (1u << nibble)) {
+        return span;
+    }
+
+    uint8_t *p = span;
+    for (int bit = 3; bit >= 0; bit--) {
+        Color color = (nibble & (1u << bit)) ? spanFnt : spanBg;
+        for (int i = 0; i < pixelScale; i++, p += pixelBytes) {
+            p[0] = color.b;
+            p[1] = color.g;
+            p[2] = color.r;
+            if (pixelBytes == 4) {
+                p[3] = 0;
             }
         }
     }
+    nibbleValid |= (uint16_t)(1u << nibble);
+    return span;
+}
 
-    cursorX += getRealCharWidth();
+// Misma geometría que el dibujo píxel a píxel original: el bit 7 cae en la
+// columna pixelScale y el bit 0 en la 8*pixelScale (la columna 0 queda libre)
+static void blitGlyph(uint16_t x, uint16_t y, unsigned char c, Color fntColor, Color bgColor) {
+    uint8_t pixelBytes = screenInfo->bpp / 8;
+    if (pixelBytes < 3 || pixelBytes > MAX_PIXEL_BYTES) {
+        return;
+    }
+
+    if (!sameColor(fntColor, spanFnt) || !sameColor(bgColor, spanBg)) {
+        spanFnt = fntColor;
+        spanBg = bgColor;
+        glyphCacheInvalidate();
+    }
+
+    uint32_t left = (uint32_t)x + pixelScale;
+    if (left >= screenInfo->width) {
+        return;
+    }
+
+    // Recorte contra el borde derecho: solo se copian los bytes visibles
+    uint32_t visible = screenInfo->width - left;
+    if (visible > 8u * pixelScale) {
+        visible = 8u * pixelScale;
+    }
+    uint32_t halfBytes = 4u * pixelScale * pixelBytes;
+    uint32_t rowBytes = visible * pixelBytes;
+    uint32_t firstBytes = rowBytes < halfBytes ? rowBytes : halfBytes;
+
+    const unsigned char *glyph = font_bitmap + 16 * (c - 32);
+    uint8_t *row = (uint8_t *)getPixelPtr(left, y);
+    uint32_t py = y;
+
+    markDirty(left, y, visible, 16u * pixelScale);
+
+    for (int cy = 0; cy < 16; cy++) {
+        const uint8_t *high = nibbleSpan(glyph[cy] >> 4, pixelBytes);
+        const uint8_t *low = nibbleSpan(glyph[cy] & 0x0F, pixelBytes);
+        for (int j = 0; j < pixelScale; j++, py++, row += screenInfo->pitch) {
+            if (py >= screenInfo->height) {
+                return;
+            }
+            memcpy(row, high, firstBytes);
+            if (rowBytes > halfBytes) {
+                memcpy(row + halfBytes, low, rowBytes - halfBytes);
+            }
+        }
+    }
 }
 
 
 
+// Sube todo una línea de texto moviendo filas enteras (respetando pitch) y
+// limpia la línea que queda libre abajo; con back buffer nunca lee video
 static void scrollUp (){
-    Color* pixel, *next;
-    for (int i = 0 ; i < cursorY + HEIGHT_FONT*pixelScale ; i++){
-        for (int j = 0 ; j < screenInfo->width ; j++){
-            pixel = (Color *) getPixelPtr(j,i);
-            next = (Color *) getPixelPtr(j,i+HEIGHT_FONT*pixelScale);
-            *pixel = *next;
+    uint32_t lineHeight = getRealCharHeight();
+    uint32_t rows = cursorY;   // filas que sobreviven: [lineHeight, cursorY + lineHeight)
+    uint32_t rowBytes = (uint32_t)screenInfo->width * (screenInfo->bpp / 8);
+    uint8_t *fb = (uint8_t *)getPixelPtr(0, 0);
+
+    // Cada fila destino está lineHeight filas arriba de su origen: copiar de a
+    // una fila nunca solapa
+    for (uint32_t i = 0; i < rows; i++) {
+        memcpy(fb + i * screenInfo->pitch, fb + (i + lineHeight) * screenInfo->pitch, rowBytes);
+    }
+
+    markDirty(0, 0, screenInfo->width, rows);
+    fillRows(cursorY, lineHeight, BLACK);
+}
+
+// Rellena con un patrón de 12 bytes (múltiplo de 3 y de 4 bytes por píxel)
+// escrito de a palabras de 32 bits, sin leer nunca del framebuffer
+static void fillRows(uint32_t y, uint32_t count, Color color) {
+    if (y >= screenInfo->height) {
+        return;
+    }
+    if (count > screenInfo->height - y) {
+        count = screenInfo->height - y;
+    }
+
+    uint8_t pixelBytes = screenInfo->bpp / 8;
+    uint32_t pattern[3];
+    uint8_t *pb = (uint8_t *)pattern;
+    for (uint32_t k = 0; k < sizeof(pattern); k += pixelBytes) {
+        pb[k] = color.b;
+        pb[k + 1] = color.g;
+        pb[k + 2] = color.r;
+        if (pixelBytes == 4) {
+            pb[k + 3] = 0;
+        }
+    }
+
+    uint32_t rowBytes = (uint32_t)screenInfo->width * pixelBytes;
+    uint32_t words = rowBytes / 4;
+    uint8_t *row = (uint8_t *)getPixelPtr(0, y);
+
+    markDirty(0, y, screenInfo->width, count);
+
+    for (uint32_t i = 0; i < count; i++, row += screenInfo->pitch) {
+        uint32_t *w = (uint32_t *)row;
+        uint32_t k = 0;
+        uint32_t idx = 0;
+        for (; k < words; k++) {
+            w[k] = pattern[idx];
+            if (++idx == 3) {
+                idx = 0;
+            }
+        }
+        for (uint32_t b = k * 4; b < rowBytes; b++) {
+            row[b] = pb[b % sizeof(pattern)];
         }
     }
 }
@@ -293,15 +433,112 @@ static uint32_t uintToBase(uint64_t value, char * buffer, uint32_t base){
 
 
 
-//te paso una coordenada de la pantalla en (x,y) y te devuelvo la direccion de la pantalla que representa ese pixel
+//te paso una coordenada de la pantalla en (x,y) y te devuelvo la direccion del back buffer que representa ese pixel
+//(el back buffer tiene el mismo pitch que el framebuffer)
 static uint32_t* getPixelPtr(uint16_t x, uint16_t y) {
     uint8_t pixelwidth = screenInfo->bpp/8;     //la cantidad de bytes hasta el siguiente pixel a la derecha (bpp: BITS per px)
     uint16_t pixelHeight = screenInfo->pitch;   //la cantidad de bytes hasta el pixel hacia abajo
 
-    uintptr_t pixelPtr = (uintptr_t)(screenInfo->framebuffer) + (x * pixelwidth) + (y * pixelHeight);
+    uintptr_t base = backBuffer != NULL ? (uintptr_t)backBuffer : (uintptr_t)screenInfo->framebuffer;
+    uintptr_t pixelPtr = base + (x * pixelwidth) + (y * pixelHeight);
     return (uint32_t*)pixelPtr;
 }
 
+// Extiende el tramo sucio de cada fila afectada (recortado a la pantalla)
+static void markDirty(uint32_t x, uint32_t y, uint32_t w, uint32_t h) {
+    if (backBuffer == NULL || x >= screenInfo->width || y >= screenInfo->height) {
+        return;
+    }
+    uint32_t x2 = (w > screenInfo->width - x) ? screenInfo->width : x + w;
+    uint32_t y2 = (h > screenInfo->height - y) ? screenInfo->height : y + h;
+
+    for (uint32_t row = y; row < y2; row++) {
+        if (dirtyHi[row] == 0) {
+            dirtyLo[row] = (uint16_t)x;
+            dirtyHi[row] = (uint16_t)x2;
+        } else {
+            if (x < dirtyLo[row]) {
+                dirtyLo[row] = (uint16_t)x;
+            }
+            if (x2 > dirtyHi[row]) {
+                dirtyHi[row] = (uint16_t)x2;
+            }
+        }
+    }
+    if (dirtyBottom == 0 || y < dirtyTop) {
+        dirtyTop = y;
+    }
+    if (y2 > dirtyBottom) {
+        dirtyBottom = y2;
+    }
+}
+
+// Activa el back buffer si el modo de video entra en la región reservada
+// y la RAM que informa Pure64 la cubre
+void vDriver_init(void) {
+    uint8_t pixelBytes = screenInfo->bpp / 8;
+    uint64_t size = (uint64_t)screenInfo->pitch * screenInfo->height;
+    if (pixelBytes < 3 || pixelBytes > MAX_PIXEL_BYTES ||
+        screenInfo->height > MAX_SCREEN_ROWS || size > BACK_BUFFER_MAX ||
+        infomap_ram_bytes() < BACK_BUFFER_ADDR + size) {
+        return;  // sin back buffer: se sigue dibujando directo
+    }
+
+    backBuffer = (uint8_t *)BACK_BUFFER_ADDR;
+    memcpy(backBuffer, (void *)(uintptr_t)screenInfo->framebuffer, size);
+    dirtyTop = 0;
+    dirtyBottom = 0;
+}
+
+// Copia al framebuffer solo los tramos sucios y los marca limpios
+void vDriver_flush(void) {
+    if (backBuffer == NULL || dirtyBottom == 0) {
+        return;
+    }
+
+    uint8_t pixelBytes = screenInfo->bpp / 8;
+    uint8_t *front = (uint8_t *)(uintptr_t)screenInfo->framebuffer;
+
+    for (uint32_t row = dirtyTop; row < dirtyBottom; row++) {
+        if (dirtyHi[row] == 0) {
+            continue;
+        }
+        uint64_t offset = (uint64_t)row * screenInfo->pitch + (uint64_t)dirtyLo[row] * pixelBytes;
+        memcpy(front + offset, backBuffer + offset, (uint64_t)(dirtyHi[row] - dirtyLo[row]) * pixelBytes);
+        dirtyHi[row] = 0;
+    }
+    dirtyTop = 0;
+    dirtyBottom = 0;
+}
+
+// Llamado desde el timer: publica lo dibujado salvo que haya un batch abierto
+void vDriver_tick(void) {
+    if (batchDepth > 0) {
+        if (ticks_elapsed() - batchStart < ms_to_ticks(BATCH_TIMEOUT_MS)) {
+            return;
+        }
+        batchDepth = 0;  // batch abandonado (p. ej. el proceso murió)
+    }
+    vDriver_flush();
+}
+
+// Agrupa varios dibujos en un único flush (anidable)
+void vDriver_batchBegin(void) {
+    if (batchDepth == 0) {
+        batchStart = ticks_elapsed();
+    }
+    batchDepth++;
+}
+
+void vDriver_batchEnd(void) {
+    if (batchDepth > 0) {
+        batchDepth--;
+    }
+    if (batchDepth == 0) {
+        vDriver_flush();
+    }
+}
+
 
 
 //pinto un pixel de la pantalla con el color que quiero, 
@@ -311,6 +548,7 @@ void vDriver_setPixel(uint16_t x, uint16_t y, Color color) {
 
     Color* pixel = (Color*) getPixelPtr(x, y);
     *pixel = color;
+    markDirty(x, y, 1, 1);
 }
 
 
@@ -324,6 +562,9 @@ void vDriver_drawRectangle(int x, int y, int w, int h, Color color){
             *pixel = color;
         }
     }
+    if (x >= 0 && y >= 0 && w > 0 && h > 0) {
+        markDirty((uint32_t)x, (uint32_t)y, (uint32_t)w, (uint32_t)h);
+    }
 }
 
 
@@ -7,6 +7,7 @@
 #include "errno.h"
 #include "sched.h"
 #include "memory_manager.h"
+#include "poll.h"
 
 
 // Archivos globales para entrada/salida estándar
@@ -44,7 +45,7 @@ static int fd_tty_read(file_t *file, void *buf, int n) {
         return E_BG_INPUT;
     }
 
-    return tty_read((tty_t *)file->ptr, buf, n);
+    return tty_read((tty_t *)file->ptr, buf, n, (file->flags & O_NONBLOCK) != 0);
 }
 
 // Escribe datos desde el buffer hacia un TTY (terminal)
@@ -55,6 +56,31 @@ static int fd_tty_write(file_t *file, const void *buf, int n) {
     return tty_write((tty_t *)file->ptr, buf, n);
 }
 
+// Versiones vectoriales: mismos chequeos que read/write
+static int fd_tty_readv(file_t *file, const iovec_t *iov, int cnt) {
+    if (file == NULL || !file->can_read || file->ptr == NULL) {
+        return -1;
+    }
+
+    pcb_t *cur = sched_current();
+    if (cur == NULL) {
+        return -1;
+    }
+
+    if (file->fg_read_guard && !tty_can_read(cur->pid)) {
+        return E_BG_INPUT;
+    }
+
+    return tty_readv((tty_t *)file->ptr, iov, cnt, (file->flags & O_NONBLOCK) != 0);
+}
+
+static int fd_tty_writev(file_t *file, const iovec_t *iov, int cnt) {
+    if (file == NULL || !file->can_write || file->ptr == NULL) {
+        return -1;
+    }
+    return tty_writev((tty_t *)file->ptr, iov, cnt);
+}
+
 // Cierra un TTY (terminal)
 static int fd_tty_close(file_t *file) {
     if (file == NULL || file->ptr == NULL) {
@@ -63,11 +89,44 @@ static int fd_tty_close(file_t *file) {
     return tty_close((tty_t *)file->ptr);
 }
 
+// Consulta la disponibilidad de un TTY para sys_poll
+static int fd_tty_poll(file_t *file, struct wait_node *w) {
+    if (file == NULL || file->ptr == NULL) {
+        return POLLNVAL;
+    }
+
+    int mask = 0;
+    if (file->can_read) {
+        pcb_t *cur = sched_current();
+        if (file->fg_read_guard && (cur == NULL || !tty_can_read(cur->pid))) {
+            mask |= POLLERR;  // un read fallaría con E_BG_INPUT sin bloquear
+        } else {
+            mask |= tty_poll((tty_t *)file->ptr, w);
+        }
+    }
+    if (file->can_write) {
+        mask |= POLLOUT;
+    }
+    return mask;
+}
+
+// Cambia o consulta la disciplina de línea (modo canónico / raw)
+static int fd_tty_ioctl(file_t *file, int request, int arg) {
+    if (file == NULL || file->ptr == NULL) {
+        return -1;
+    }
+    return tty_ioctl((tty_t *)file->ptr, request, arg);
+}
+
 // Estructura con las operaciones para archivos TTY
 static const struct fd_ops TTY_OPS = {
     .read = fd_tty_read,
     .write = fd_tty_write,
-    .close = fd_tty_close
+    .close = fd_tty_close,
+    .poll = fd_tty_poll,
+    .ioctl = fd_tty_ioctl,
+    .readv = fd_tty_readv,
+    .writev = fd_tty_writev
 };
 
 // Inicializa el sistema de descriptores de archivos
@@ -115,6 +174,7 @@ file_t *file_create(fd_type_t type, void *ptr, bool rd, bool wr, const struct fd
     file->can_read = rd;
     file->can_write = wr;
     file->fg_read_guard = false;
+    file->flags = 0;
     file->refcount = 1;
     return file;
 }
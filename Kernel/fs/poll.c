@@ -0,0 +1,147 @@
+#include <stddef.h>
+#include "poll.h"
+#include "fd.h"
+#include "sched.h"
+#include "time.h"
+#include "errno.h"
+#include "interrupts.h"
+
+// sys_poll: registra al proceso en la cola de poll de cada recurso y lo
+// bloquea hasta que alguno esté listo, venza el timeout o llegue un wakeup
+
+static uint64_t irq_save(void);
+static void irq_restore(uint64_t flags);
+static int poll_scan(pcb_t *cur, pollfd_t *fds, int n, wait_node_t *nodes);
+static bool poll_woken(pcb_t *proc);
+static void poll_unregister(pcb_t *proc);
+
+static uint64_t irq_save(void) {
+    uint64_t flags;
+    __asm__ volatile("pushfq\n\tpop %0" : "=r"(flags));
+    _cli();
+    return flags;
+}
+
+static void irq_restore(uint64_t flags) {
+    if (flags & (1ULL << 9)) {
+        _sti();
+    }
+}
+
+// Evalúa cada fd; si nodes != NULL además registra al proceso en cada recurso
+static int poll_scan(pcb_t *cur, pollfd_t *fds, int n, wait_node_t *nodes) {
+    int ready = 0;
+
+    for (int i = 0; i < n; i++) {
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
+            continue;  // fds negativos se ignoran
+        }
+
+        file_t *file = fd_table_get(cur->fd_table, fds[i].fd);
+        int mask;
+        if (file == NULL) {
+            mask = POLLNVAL;
+        } else if (file->ops == NULL || file->ops->poll == NULL) {
+            mask = POLLIN | POLLOUT;  // sin soporte de poll: nunca bloquea
+        } else {
+            wait_node_t *w = NULL;
+            if (nodes != NULL) {
+                w = &nodes[cur->poll_count++];
+                w->proc = NULL;   // queda NULL si el recurso no lo registra
+                w->queue = NULL;
+            }
+            mask = file->ops->poll(file, w);
+        }
+
+        fds[i].revents = (int16_t)(mask & (fds[i].events | POLLERR | POLLHUP | POLLNVAL));
+        if (fds[i].revents != 0) {
+            ready++;
+        }
+    }
+
+    return ready;
+}
+
+// Un recurso que despierta a sus pollers los saca de la cola: si alguno de
+// nuestros nodos registrados ya no está encolado, hubo un wakeup desde el registro
+static bool poll_woken(pcb_t *proc) {
+    for (int i = 0; i < proc->poll_count; i++) {
+        wait_node_t *w = &proc->poll_nodes[i];
+        if (w->proc != NULL && __atomic_load_n(&w->queue, __ATOMIC_ACQUIRE) == NULL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void poll_unregister(pcb_t *proc) {
+    if (proc->poll_nodes != NULL) {
+        for (int i = 0; i < proc->poll_count; i++) {
+            wait_queue_detach(&proc->poll_nodes[i]);
+        }
+    }
+    proc->poll_nodes = NULL;
+    proc->poll_count = 0;
+}
+
+// timeout_ms < 0 espera indefinidamente; 0 solo consulta
+int kpoll(pollfd_t *fds, int n, int timeout_ms) {
+    if (fds == NULL || n <= 0 || n > POLL_MAX_FDS) {
+        return E_INVAL;
+    }
+
+    pcb_t *cur = sched_current();
+    if (cur == NULL || cur->fd_table == NULL) {
+        return -1;
+    }
+
+    wait_node_t nodes[POLL_MAX_FDS];
+    uint64_t deadline = 0;
+    if (timeout_ms > 0) {
+        deadline = ticks_elapsed() + ms_to_ticks(timeout_ms);
+    }
+
+    while (1) {
+        uint64_t flags = irq_save();
+
+        bool expired = (timeout_ms == 0) ||
+                       (timeout_ms > 0 && ticks_elapsed() >= deadline);
+
+        cur->poll_count = 0;
+        cur->poll_nodes = expired ? NULL : nodes;
+
+        int ready = poll_scan(cur, fds, n, cur->poll_nodes);
+        if (ready > 0 || expired || poll_woken(cur)) {
+            poll_unregister(cur);
+            irq_restore(flags);
+            if (ready > 0 || expired) {
+                return ready;
+            }
+            continue;  // wakeup entre el registro y el chequeo: re-evaluar
+        }
+
+        cur->state = BLOCKED;
+        cur->ticks_left = 0;
+        if (timeout_ms > 0) {
+            sched_arm_timeout(cur, deadline);
+        }
+        irq_restore(flags);
+
+        sched_force_yield();
+
+        flags = irq_save();
+        sched_cancel_timeout(cur);
+        poll_unregister(cur);
+        irq_restore(flags);
+    }
+}
+
+void poll_cancel(pcb_t *proc) {
+    if (proc == NULL) {
+        return;
+    }
+    uint64_t flags = irq_save();
+    poll_unregister(proc);
+    irq_restore(flags);
+}
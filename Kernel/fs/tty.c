@@ -1,19 +1,30 @@
 #include <stddef.h>
 #include "tty.h"
-#include "memory_manager.h"
 #include "interrupts.h"
 #include "lib.h"
 #include "sched.h"
 #include "videoDriver.h"
+#include "poll.h"
+#include "errno.h"
+#include "irqtrace.h"
 
-// Backend de la TTY principal: buffer circular + colas de procesos bloqueados
+// Backend de la TTY principal: buffer circular + colas de procesos bloqueados.
+// Disciplina de línea: en modo canónico las teclas se editan y se hace eco
+// en el kernel, y solo las líneas terminadas (Enter, Ctrl+D o línea llena)
+// pasan al buffer que leen los procesos. En modo raw cada tecla va directo.
 
 #define TTY_BUFFER_CAP 256
-
-typedef struct tty_waiter {
-    pcb_t *proc;
-    struct tty_waiter *next;
-} tty_waiter_t;
+#define TTY_LINE_MAX   128
+#define ANSI_MAX_PARAMS 8
+#define ANSI_ESC 0x1B
+#define TTY_WRITE_CHUNK 256   // bytes de texto entre puntos de preemption
+
+// Estado del parser de secuencias de escape de tty_write
+typedef enum {
+    ANSI_TEXT,
+    ANSI_ESCAPE,   // se leyó ESC
+    ANSI_CSI       // se leyó ESC [
+} ansi_state_t;
 
 struct tty {
     char buffer[TTY_BUFFER_CAP];
@@ -21,11 +32,37 @@ struct tty {
     uint32_t tail;
     uint32_t size;
     bool eof;
-    tty_waiter_t *wait_head;
-    tty_waiter_t *wait_tail;
+    int lflags;                // TTY_ICANON | TTY_ECHO
+    char line[TTY_LINE_MAX];   // línea en edición (modo canónico)
+    int line_len;
+    wait_queue_t readers;      // procesos bloqueados en tty_read
+    wait_queue_t pollers;      // procesos esperando en sys_poll
     int fg_pid;  // PID del proceso foreground que controla la TTY
+    ansi_state_t ansi_state;
+    int ansi_params[ANSI_MAX_PARAMS];
+    int ansi_nparams;          // índice del parámetro que se está leyendo
+    Color fg;                  // colores actuales de salida (SGR)
+    Color bg;
+};
+
+// Paleta ANSI estándar (0-7) y brillante (8-15), en el orden b, g, r de Color
+static const Color ansi_palette[16] = {
+    {0, 0, 0}, {0, 0, 170}, {0, 170, 0}, {0, 85, 170},
+    {170, 0, 0}, {170, 0, 170}, {170, 170, 0}, {170, 170, 170},
+    {85, 85, 85}, {85, 85, 255}, {85, 255, 85}, {85, 255, 255},
+    {255, 85, 85}, {255, 85, 255}, {255, 255, 85}, {255, 255, 255}
 };
 
+static void ansi_feed(tty_t *t, char c);
+static void ansi_apply_sgr(tty_t *t);
+static void buffer_put(tty_t *t, char c);
+static void commit_line(tty_t *t);
+static int canon_input(tty_t *t, char c, char *echo);
+static bool is_ctl(char c);
+static int echo_form(char c, char *echo);
+static void tty_echo(tty_t *t, const char *echo, int len);
+static void wake_readers(tty_t *t, uint64_t flags);
+
 static tty_t default_tty;
 static bool default_tty_initialized = false;
 
@@ -44,67 +81,68 @@ static void irq_restore_local(uint64_t flags) {
     }
 }
 
-// Agrega un proceso a la cola de espera del TTY
-static void enqueue_waiter(tty_t *t, pcb_t *proc, tty_waiter_t *node) {
-    if (node == NULL) {
-        return;
-    }
-    node->proc = proc;
-    node->next = NULL;
-
-    if (t->wait_tail == NULL) {
-        t->wait_head = t->wait_tail = node;
-    } else {
-        t->wait_tail->next = node;
-        t->wait_tail = node;
-    }
-}
-
-// Remueve y retorna el primer proceso de la cola de espera del TTY
-static pcb_t *dequeue_waiter(tty_t *t) {
-    if (t->wait_head == NULL) {
-        return NULL;
-    }
-
-    tty_waiter_t *node = t->wait_head;
-    t->wait_head = node->next;
-    if (t->wait_head == NULL) {
-        t->wait_tail = NULL;
-    }
-
-    pcb_t *proc = node->proc;
-    mm_free(node);
-    return proc;
-}
-
 // Devuelve la instancia única del TTY por defecto (inicializa si es necesario)
 tty_t *tty_default(void) {
     if (!default_tty_initialized) {
         memset(&default_tty, 0, sizeof(default_tty));
+        wait_queue_init(&default_tty.readers, NULL);
+        wait_queue_init(&default_tty.pollers, NULL);
         default_tty.fg_pid = -1;  // Inicialmente sin foreground
+        default_tty.lflags = TTY_ICANON | TTY_ECHO;
+        default_tty.ansi_state = ANSI_TEXT;
+        default_tty.fg = WHITE;
+        default_tty.bg = BLACK;
         default_tty_initialized = true;
     }
     return &default_tty;
 }
 
-// Lee hasta n bytes del buffer del TTY (bloqueante si no hay datos)
-int tty_read(tty_t *t, void *buf, int n) {
-    if (t == NULL || buf == NULL || n <= 0) {
+// Lee hasta n bytes del buffer del TTY (bloqueante si no hay datos, salvo nonblock)
+int tty_read(tty_t *t, void *buf, int n, bool nonblock) {
+    if (buf == NULL || n <= 0) {
+        return -1;
+    }
+    iovec_t iov = {buf, (uint64_t)n};
+    return tty_readv(t, &iov, 1, nonblock);
+}
+
+// Como tty_read, repartiendo lo disponible entre los iovecs en orden
+int tty_readv(tty_t *t, const iovec_t *iov, int cnt, bool nonblock) {
+    if (t == NULL || iov == NULL || cnt <= 0) {
+        return -1;
+    }
+
+    uint64_t want = 0;
+    for (int i = 0; i < cnt; i++) {
+        want += iov[i].iov_len;
+    }
+    if (want == 0) {
         return -1;
     }
 
-    char *dst = (char *)buf;
     int total = 0;
 
-    while (total < n) {
+    while (1) {
         uint64_t flags = irq_save_local();
 
         if (t->size > 0) {
-            int to_read = (t->size < (uint32_t)(n - total)) ? (int)t->size : (n - total);
-            for (int i = 0; i < to_read; i++) {
-                dst[total++] = t->buffer[t->head];
-                t->head = (t->head + 1) % TTY_BUFFER_CAP;
-                t->size--;
+            // En modo canónico una lectura devuelve a lo sumo una línea
+            bool canon = (t->lflags & TTY_ICANON) != 0;
+            bool line_done = false;
+            for (int i = 0; i < cnt && t->size > 0 && !line_done; i++) {
+                char *dst = (char *)iov[i].iov_base;
+                uint64_t len = 0;
+                while (t->size > 0 && len < iov[i].iov_len) {
+                    char c = t->buffer[t->head];
+                    dst[len++] = c;
+                    t->head = (t->head + 1) % TTY_BUFFER_CAP;
+                    t->size--;
+                    if (canon && c == '\n') {
+                        line_done = true;
+                        break;
+                    }
+                }
+                total += (int)len;
             }
 
             irq_restore_local(flags);
@@ -121,33 +159,19 @@ int tty_read(tty_t *t, void *buf, int n) {
             return total;
         }
 
-        pcb_t *current = sched_current();
-        if (current == NULL) {
+        if (nonblock) {
             irq_restore_local(flags);
-            return -1;
-        }
-
-        // Pre-allocate waiter before it's needed
-        // Temporarily exit critical section to allocate
-        irq_restore_local(flags);
-
-        tty_waiter_t *waiter = (tty_waiter_t *)mm_malloc(sizeof(tty_waiter_t));
-        if (waiter == NULL) {
-            return -1;  // Memory allocation failed
+            return E_AGAIN;
         }
 
-        // Re-enter critical section
-        flags = irq_save_local();
-
-        // Double-check conditions after re-entering
-        if (t->size > 0 || t->eof) {
-            // Data became available or EOF while we were allocating
+        pcb_t *current = sched_current();
+        if (current == NULL) {
             irq_restore_local(flags);
-            mm_free(waiter);
-            continue;  // Retry read
+            return -1;
         }
 
-        enqueue_waiter(t, current, waiter);
+        // Encolar el nodo embebido del PCB: sin asignar memoria al bloquear
+        wait_queue_add(&t->readers, &current->wait_node, current);
         current->state = BLOCKED;
         current->ticks_left = 0;
 
@@ -155,24 +179,144 @@ int tty_read(tty_t *t, void *buf, int n) {
 
         sched_force_yield();
     }
+}
 
-    return total;
+// Reporta POLLIN si hay datos o un EOF pendiente; registra w si se pasa
+int tty_poll(tty_t *t, struct wait_node *w) {
+    if (t == NULL) {
+        return POLLNVAL;
+    }
+
+    uint64_t flags = irq_save_local();
+    if (w != NULL) {
+        wait_queue_add(&t->pollers, w, sched_current());
+    }
+    int mask = (t->size > 0 || t->eof) ? POLLIN : 0;
+    irq_restore_local(flags);
+    return mask;
 }
 
-// Escribe n bytes del buffer en la pantalla
+// Escribe n bytes en la pantalla: cada tramo sin escapes va de una vez al
+// driver y las secuencias SGR solo cambian los colores de la TTY
 int tty_write(tty_t *t, const void *buf, int n) {
-    (void)t;
-    if (buf == NULL || n <= 0) {
+    if (t == NULL || buf == NULL || n <= 0) {
         return -1;
     }
 
     const char *src = (const char *)buf;
-    for (int i = 0; i < n; i++) {
-        vDriver_print(src[i], WHITE, BLACK);
+    int i = 0;
+    while (i < n) {
+        if (t->ansi_state == ANSI_TEXT) {
+            int start = i;
+            while (i < n && src[i] != ANSI_ESC && i - start < TTY_WRITE_CHUNK) {
+                i++;
+            }
+            vDriver_write(src + start, i - start, t->fg, t->bg);
+            if (i - start == TTY_WRITE_CHUNK) {
+                // Entre tramos de texto el parser está en reposo: se puede ceder
+                sched_preempt_point();
+            } else if (i < n) {
+                t->ansi_state = ANSI_ESCAPE;
+                i++;
+            }
+        } else {
+            ansi_feed(t, src[i++]);
+        }
     }
     return n;
 }
 
+// Cada iovec pasa por tty_write; el estado ANSI sigue de uno al siguiente,
+// así una secuencia de escape puede quedar partida entre dos buffers
+int tty_writev(tty_t *t, const iovec_t *iov, int cnt) {
+    if (t == NULL || iov == NULL || cnt <= 0) {
+        return -1;
+    }
+
+    int total = 0;
+    for (int i = 0; i < cnt; i++) {
+        if (iov[i].iov_len > 0) {
+            total += tty_write(t, iov[i].iov_base, (int)iov[i].iov_len);
+        }
+    }
+    return total;
+}
+
+// Avanza el parser con un byte de una secuencia de escape
+static void ansi_feed(tty_t *t, char c) {
+    if (t->ansi_state == ANSI_ESCAPE) {
+        if (c == '[') {
+            t->ansi_state = ANSI_CSI;
+            t->ansi_nparams = 0;
+            t->ansi_params[0] = 0;
+        } else {
+            t->ansi_state = ANSI_TEXT;  // solo se soporta CSI: se descarta
+        }
+        return;
+    }
+
+    if (c >= '0' && c <= '9') {
+        int *param = &t->ansi_params[t->ansi_nparams];
+        if (*param < 10000) {
+            *param = *param * 10 + (c - '0');
+        }
+    } else if (c == ';') {
+        if (t->ansi_nparams < ANSI_MAX_PARAMS - 1) {
+            t->ansi_nparams++;
+        }
+        t->ansi_params[t->ansi_nparams] = 0;
+    } else if (c >= 0x40 && c <= 0x7E) {
+        // Byte final: solo 'm' (SGR) tiene efecto, el resto se ignora
+        if (c == 'm') {
+            ansi_apply_sgr(t);
+        }
+        t->ansi_state = ANSI_TEXT;
+    }
+}
+
+static void ansi_apply_sgr(tty_t *t) {
+    int count = t->ansi_nparams + 1;
+    int *p = t->ansi_params;
+
+    for (int i = 0; i < count; i++) {
+        int code = p[i];
+        if (code == 0) {
+            t->fg = WHITE;
+            t->bg = BLACK;
+        } else if (code >= 30 && code <= 37) {
+            t->fg = ansi_palette[code - 30];
+        } else if (code >= 90 && code <= 97) {
+            t->fg = ansi_palette[code - 90 + 8];
+        } else if (code == 39) {
+            t->fg = WHITE;
+        } else if (code >= 40 && code <= 47) {
+            t->bg = ansi_palette[code - 40];
+        } else if (code >= 100 && code <= 107) {
+            t->bg = ansi_palette[code - 100 + 8];
+        } else if (code == 49) {
+            t->bg = BLACK;
+        } else if ((code == 38 || code == 48) && i + 1 < count) {
+            Color color;
+            if (p[i + 1] == 2 && i + 4 < count) {
+                color.r = (uint8_t)p[i + 2];
+                color.g = (uint8_t)p[i + 3];
+                color.b = (uint8_t)p[i + 4];
+                i += 4;
+            } else if (p[i + 1] == 5 && i + 2 < count && p[i + 2] < 16) {
+                color = ansi_palette[p[i + 2]];
+                i += 2;
+            } else {
+                break;  // forma no soportada: ignorar el resto
+            }
+            if (code == 38) {
+                t->fg = color;
+            } else {
+                t->bg = color;
+            }
+        }
+    }
+}
+
 // Cierra el TTY (operación vacía, solo para compatibilidad)
 int tty_close(tty_t *t) {
     (void)t;
@@ -181,6 +325,7 @@ int tty_close(tty_t *t) {
 
 // Agrega un carácter al buffer del TTY y despierta procesos bloqueados
 void tty_push_char(tty_t *t, char c) {
+    irqtrace_kbd_push();
     if (t == NULL) {
         return;
     }
@@ -189,11 +334,11 @@ void tty_push_char(tty_t *t, char c) {
 
     // Manejar Ctrl+C (ETX = 0x03)
     if (c == 3) {
+        t->line_len = 0;  // se descarta la línea a medio editar
         irq_restore_local(flags);
         
         // Obtener el proceso en foreground y matarlo
-        const char *sigint_msg = "^C\n";
-        tty_write(t, sigint_msg, 3);
+        tty_echo(t, "^C\n", 3);
         int fg_pid = proc_get_foreground_pid();
         if (fg_pid > 0) {
             proc_kill(fg_pid);
@@ -201,16 +346,70 @@ void tty_push_char(tty_t *t, char c) {
         return;
     }
 
-    if (c == 4) {
-        t->eof = true;
-        pcb_t *proc = dequeue_waiter(t);
-        irq_restore_local(flags);
-        if (proc != NULL) {
-            proc_unblock(proc->pid);
+    if (t->lflags & TTY_ICANON) {
+        char echo[3];
+        int echo_len = canon_input(t, c, echo);
+        bool ready = (t->size > 0 || t->eof);
+        if (ready) {
+            wake_readers(t, flags);
+        } else {
+            irq_restore_local(flags);
+        }
+        if (echo_len > 0) {
+            tty_echo(t, echo, echo_len);
         }
         return;
     }
 
+    if (c == 4) {
+        t->eof = true;
+    } else {
+        buffer_put(t, c);
+    }
+    wake_readers(t, flags);
+
+    if ((t->lflags & TTY_ECHO) && c != 4) {
+        char echo[2];
+        tty_echo(t, echo, echo_form(c, echo));
+    }
+}
+
+// Controles que no tienen efecto propio en pantalla (Esc, Ctrl+letra, DEL)
+static bool is_ctl(char c) {
+    return ((unsigned char)c < 0x20 && c != '\n' && c != '\t' && c != '\b') || c == 0x7F;
+}
+
+// Como ECHOCTL: los controles se muestran como ^X
+static int echo_form(char c, char *echo) {
+    if (is_ctl(c)) {
+        echo[0] = '^';
+        echo[1] = (c == 0x7F) ? '?' : (char)(c + '@');
+        return 2;
+    }
+    echo[0] = c;
+    return 1;
+}
+
+// El eco va directo al driver: los bytes tipeados no pasan por el parser
+// ANSI de tty_write, así un Esc no le come la salida al programa
+static void tty_echo(tty_t *t, const char *echo, int len) {
+    vDriver_write(echo, len, t->fg, t->bg);
+}
+
+// Despierta a un lector y a los pollers; restaura las interrupciones
+static void wake_readers(tty_t *t, uint64_t flags) {
+    pcb_t *proc = wait_queue_pop(&t->readers);
+    wait_queue_wake_all(&t->pollers);
+
+    irq_restore_local(flags);
+
+    if (proc != NULL) {
+        proc_unblock(proc->pid);
+    }
+}
+
+// Agrega un byte al buffer de lectura; si está lleno se pierde el más viejo
+static void buffer_put(tty_t *t, char c) {
     if (t->size == TTY_BUFFER_CAP) {
         t->head = (t->head + 1) % TTY_BUFFER_CAP;
         t->size--;
@@ -219,13 +418,79 @@ void tty_push_char(tty_t *t, char c) {
     t->buffer[t->tail] = c;
     t->tail = (t->tail + 1) % TTY_BUFFER_CAP;
     t->size++;
+}
+
+// Pasa la línea en edición al buffer de lectura
+static void commit_line(tty_t *t) {
+    for (int i = 0; i < t->line_len; i++) {
+        buffer_put(t, t->line[i]);
+    }
+    t->line_len = 0;
+}
 
-    pcb_t *proc = dequeue_waiter(t);
+// Edición de la línea en modo canónico, con las interrupciones deshabilitadas.
+// Deja en echo lo que hay que mostrar y devuelve su largo
+static int canon_input(tty_t *t, char c, char *echo) {
+    bool do_echo = (t->lflags & TTY_ECHO) != 0;
 
-    irq_restore_local(flags);
+    if (c == 4) {
+        // Ctrl+D: con la línea vacía es EOF; si no, entrega lo escrito sin '\n'
+        if (t->line_len == 0) {
+            t->eof = true;
+        } else {
+            commit_line(t);
+        }
+        return 0;
+    }
 
-    if (proc != NULL) {
-        proc_unblock(proc->pid);
+    if (c == '\b' || c == 0x7F) {
+        if (t->line_len == 0) {
+            return 0;
+        }
+        // Un control se mostró como ^X: hay que borrar dos columnas
+        int cols = is_ctl(t->line[--t->line_len]) ? 2 : 1;
+        echo[0] = '\b';
+        echo[1] = '\b';
+        return do_echo ? cols : 0;
+    }
+
+    t->line[t->line_len++] = c;
+    if (c == '\n' || t->line_len == TTY_LINE_MAX) {
+        commit_line(t);
+    }
+    return do_echo ? echo_form(c, echo) : 0;
+}
+
+// TTY_GETFLAGS devuelve los flags; TTY_SETFLAGS los reemplaza. Al salir del
+// modo canónico lo que se estaba editando pasa tal cual a los lectores
+int tty_ioctl(tty_t *t, int request, int arg) {
+    if (t == NULL) {
+        return -1;
+    }
+
+    switch (request) {
+    case TTY_GETFLAGS:
+        return t->lflags;
+    case TTY_SETFLAGS: {
+        if (arg & ~(TTY_ICANON | TTY_ECHO)) {
+            return E_INVAL;
+        }
+        uint64_t flags = irq_save_local();
+        bool flushed = false;
+        if ((t->lflags & TTY_ICANON) && !(arg & TTY_ICANON) && t->line_len > 0) {
+            commit_line(t);
+            flushed = true;
+        }
+        t->lflags = arg;
+        if (flushed) {
+            wake_readers(t, flags);
+        } else {
+            irq_restore_local(flags);
+        }
+        return 0;
+    }
+    default:
+        return E_INVAL;
     }
 }
 
@@ -0,0 +1,26 @@
+#ifndef APIC_H
+#define APIC_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define APIC_SPURIOUS_VECTOR 0xFF
+
+// Registro de EOI del LAPIC; NULL mientras se use el 8259. Lo lee el
+// macro endOfHardwareInterrupt de interrupts.asm
+extern volatile uint32_t *apic_eoi_reg;
+
+/**
+ * @brief Pasa la entrega de interrupciones al LAPIC/IO-APIC
+ * Enmascara el 8259, rutea teclado (IRQ1) y COM1 (IRQ4) por el IO-APIC a
+ * los mismos vectores que antes (0x21/0x24) y genera los ticks (TICK_HZ)
+ * con el timer del LAPIC en el vector 0x20. Si la calibración del timer falla,
+ * el PIT (IRQ0) se rutea por el IO-APIC en su lugar.
+ * Llamar con interrupciones deshabilitadas.
+ * @return false si no hay LAPIC o IO-APIC: queda el 8259 como estaba
+ */
+bool apic_init(void);
+
+bool apic_enabled(void);
+
+#endif /* APIC_H */
@@ -3,25 +3,46 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "uio.h"
 
 struct file;
 struct fd_table;
+struct wait_node;
 
 // Tipos básicos de file descriptors que maneja el kernel
 typedef enum {
     FD_NONE,
     FD_TTY,
-    FD_PIPE
+    FD_PIPE,
+    FD_SEM,
+    FD_SERIAL
 } fd_type_t;
 
 typedef struct file file_t;
 typedef struct fd_table fd_table_t;
 
+// Flags de estado del archivo (compartidos entre fds duplicados)
+#define O_NONBLOCK  0x4   // read/write devuelven E_AGAIN en lugar de bloquear
+
+// Comandos de sys_fcntl
+#define F_GETFL 1
+#define F_SETFL 2
+#define F_ISATTY 3   // 1 si el fd es la TTY (stdio elige el modo de buffer)
+
 // Operaciones que cada backend debe implementar
 struct fd_ops {
     int (*read)(file_t *file, void *buf, int n);
     int (*write)(file_t *file, const void *buf, int n);
     int (*close)(file_t *file);
+    // Retorna la máscara POLL* actual; si w != NULL registra al proceso
+    // para ser despertado cuando cambie (opcional: NULL = siempre listo)
+    int (*poll)(file_t *file, struct wait_node *w);
+    // Control específico del dispositivo (opcional: NULL = no soportado)
+    int (*ioctl)(file_t *file, int request, int arg);
+    // Versiones vectoriales (opcionales: NULL = read/write por cada iovec).
+    // iov ya está copiado al kernel y validado; cnt está en [1, IOV_MAX]
+    int (*readv)(file_t *file, const iovec_t *iov, int cnt);
+    int (*writev)(file_t *file, const iovec_t *iov, int cnt);
 };
 
 struct file {
@@ -31,6 +52,7 @@ struct file {
     bool can_read;
     bool can_write;
     bool fg_read_guard;
+    int flags;              // O_NONBLOCK
     int refcount;
 };
 
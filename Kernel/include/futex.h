@@ -0,0 +1,16 @@
+#ifndef KERNEL_FUTEX_H
+#define KERNEL_FUTEX_H
+
+#include <stdint.h>
+
+// Futex: espera/despertar keyed por dirección de un entero de 32 bits.
+// El fast path de los locks de userland es atómico; solo se entra al kernel
+// cuando hay contención. Como todos los procesos comparten el espacio de
+// direcciones, la dirección virtual alcanza como clave.
+
+#define FUTEX_HASH_BUCKETS 32
+
+int futex_wait(volatile uint32_t *addr, uint32_t expected);
+int futex_wake(volatile uint32_t *addr, int n);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef INFOMAP_H
+#define INFOMAP_H
+
+#include <stdint.h>
+
+// Datos que deja Pure64 en su InfoMap
+#define INFOMAP_RAM_MB       0x5020   // RAM instalada en MiB
+#define INFOMAP_IOAPIC_COUNT 0x5030
+#define INFOMAP_LAPIC_ADDR   0x5060
+#define INFOMAP_IOAPIC_LIST  0x5068   // por IO-APIC: dirección (32 bits) y GSI base (32 bits)
+
+// Pure64 solo garantiza los 16 bits bajos de la palabra (los guarda desde ax)
+static inline uint64_t infomap_ram_bytes(void) {
+    return (uint64_t)*(volatile uint16_t *)INFOMAP_RAM_MB << 20;
+}
+
+#endif /* INFOMAP_H */
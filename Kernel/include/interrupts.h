@@ -5,7 +5,11 @@
 
 void interrupt_keyboardHandler(void);
 void irq_timer_handler(void);
+void interrupt_serialHandler(void);
 void interrupt_systemCall(void);
+void interrupt_fastSystemCall(void);
+void interrupt_spurious(void);
+void interrupt_forceSchedule(void);
 void exception_invalidOp(void);
 void exception_zeroDiv(void);
 
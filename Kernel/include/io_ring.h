@@ -0,0 +1,48 @@
+#ifndef IO_RING_H
+#define IO_RING_H
+
+#include <stdint.h>
+
+// Ring de envío/completado por proceso: userland encola operaciones en el
+// SQ y las entrega todas con un solo sys_io_ring_enter; los resultados
+// quedan en el CQ y se leen sin más syscalls.
+//
+// Las colas viven en memoria de userland. Cada índice tiene un único
+// escritor: sq_tail y cq_head los avanza userland, sq_head y cq_tail el
+// kernel. Los índices crecen libremente y se enmascaran con entries - 1.
+
+#define IO_RING_MAX_ENTRIES 256   // entries debe ser potencia de 2
+
+#define IO_OP_NOP         0
+#define IO_OP_READ        1   // sys_read(fd, addr, len)
+#define IO_OP_WRITE       2   // sys_write(fd, addr, len)
+#define IO_OP_SEM_POST    3   // sys_sem_post(fd = id del semáforo)
+#define IO_OP_PIPE_WRITE  4   // sys_pipe_write(fd, addr, len)
+
+typedef struct io_sqe {
+    uint8_t  op;
+    uint8_t  reserved[3];
+    int32_t  fd;
+    uint64_t addr;
+    uint32_t len;
+    uint32_t reserved2;
+    uint64_t user_data;      // se copia tal cual al cqe
+} io_sqe_t;
+
+typedef struct io_cqe {
+    uint64_t user_data;
+    int64_t  res;            // valor de retorno de la operación
+} io_cqe_t;
+
+typedef struct io_ring {
+    volatile uint32_t sq_head;
+    volatile uint32_t sq_tail;
+    volatile uint32_t cq_head;
+    volatile uint32_t cq_tail;
+    uint32_t entries;        // tamaño del SQ y del CQ
+    uint32_t reserved;
+    io_sqe_t *sqes;
+    io_cqe_t *cqes;
+} io_ring_t;
+
+#endif /* IO_RING_H */
@@ -0,0 +1,38 @@
+#ifndef IRQLAT_STATS_H
+#define IRQLAT_STATS_H
+
+#include <stdint.h>
+
+// Traza de tramos _cli/_sti y latencia de IRQ, exportada por sys_irqlat_stats
+
+#define IRQLAT_TOP           8
+#define IRQLAT_HIST_BUCKETS  16
+#define IRQLAT_HIST_SHIFT    6   // bucket 0: < 2^7 ciclos; bucket i: [2^(i+6), 2^(i+7))
+
+// op de sys_irqlat_stats
+#define IRQLAT_STATS_READ   0
+#define IRQLAT_STATS_RESET  1
+
+typedef struct irqlat_section {
+    uint64_t cycles;
+    uint64_t cli_ip;       // retorno de _cli: el helper irq_save o quien llamó a _cli
+    uint64_t cli_caller;   // un frame más arriba: quien llamó al helper
+    uint64_t sti_ip;       // retorno de _sti/_hlt que cerró el tramo (0: lo cortó el scheduler)
+} irqlat_section_t;
+
+typedef struct irqlat_hist {
+    uint64_t count;
+    uint64_t total_cycles;
+    uint64_t max_cycles;
+    uint32_t hist[IRQLAT_HIST_BUCKETS];
+} irqlat_hist_t;
+
+typedef struct irqlat_stats {
+    uint64_t sections;                  // tramos _cli -> _sti medidos
+    uint64_t total_cycles;
+    irqlat_section_t top[IRQLAT_TOP];   // los más largos, de mayor a menor
+    irqlat_hist_t timer;                // entrada al IRQ del timer -> schedule()
+    irqlat_hist_t keyboard;             // IRQ de teclado -> tty_push_char
+} irqlat_stats_t;
+
+#endif /* IRQLAT_STATS_H */
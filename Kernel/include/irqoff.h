@@ -0,0 +1,43 @@
+#ifndef IRQOFF_H
+#define IRQOFF_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "irqoff_stats.h"
+
+// Medición de tramos con IF=0. Hay a lo sumo un sitio abierto: las
+// syscalls y los handlers de IRQ corren enteros con interrupciones
+// deshabilitadas y no se anidan. Quien vuelva a habilitarlas dentro de un
+// sitio (bloquearse, hlt, punto de preemption) tiene que pausarlo antes y
+// reanudarlo después; la pausa queda en la pila del proceso, así que
+// sobrevive a un cambio de contexto. Las tres además cortan el tramo
+// que esté midiendo irqtrace
+
+typedef struct irqoff_site {
+    const char *name;
+    uint32_t kind;
+    bool registered;
+    uint64_t count;
+    uint64_t sections;
+    uint64_t total_cycles;
+    uint64_t max_cycles;
+    struct irqoff_site *next;
+} irqoff_site_t;
+
+#define IRQOFF_SITE(n, k) { (n), (k), false, 0, 0, 0, 0, NULL }
+
+// Abre un sitio; si había otro abierto (una pausa faltante) lo cierra
+void irqoff_begin(irqoff_site_t *site);
+void irqoff_end(void);
+
+// Cierra el tramo en curso y devuelve el sitio para reanudarlo (o NULL)
+irqoff_site_t *irqoff_pause(void);
+void irqoff_resume(irqoff_site_t *site);
+
+// true si el código corre dentro de una syscall (y por lo tanto con IF=0)
+bool irqoff_in_syscall(void);
+
+int irqoff_stats(int op, irqoff_stat_t *out, int max);
+
+#endif /* IRQOFF_H */
@@ -0,0 +1,28 @@
+#ifndef IRQTRACE_H
+#define IRQTRACE_H
+
+#include <stdint.h>
+#include "irqlat_stats.h"
+
+// Traza de los tramos que abre _cli (directo o vía los irq_save de cada
+// archivo) y cierra _sti/_hlt. Solo cuentan las transiciones reales de IF:
+// un _cli con IF=0 (dentro de una syscall o un IRQ) no abre nada; esos
+// tramos los mide irqoff por sitio
+
+// Llamadas desde interrupts.asm con IF=0
+void irqtrace_cli(uint64_t ip, const uint64_t *frame);
+void irqtrace_sti(uint64_t ip);
+
+// Cierra el tramo abierto sin un _sti: al bloquearse o al entrar a un
+// sitio de irqoff (el IF=0 pasa a ser de otro contexto)
+void irqtrace_cut(void);
+
+// Latencia de IRQ: marca en la entrada, medición en el destino
+void irqtrace_timer_entry(void);
+void irqtrace_timer_schedule(void);
+void irqtrace_kbd_entry(void);
+void irqtrace_kbd_push(void);
+
+int irqtrace_stats(int op, irqlat_stats_t *out);
+
+#endif /* IRQTRACE_H */
@@ -0,0 +1,15 @@
+#ifndef KDATA_H
+#define KDATA_H
+
+#include <stdint.h>
+#include "kdata_page.h"
+
+// Se llaman con interrupciones deshabilitadas (timer y scheduler):
+// un único escritor, no hace falta lock
+void kdata_init(void);
+void kdata_tick(void);
+void kdata_set_pid(int pid);
+
+const kdata_page_t *kdata_page(void);
+
+#endif /* KDATA_H */
@@ -0,0 +1,24 @@
+#ifndef KDATA_PAGE_H
+#define KDATA_PAGE_H
+
+#include <stdint.h>
+
+// Página de datos que el kernel publica para que userland lea PID y tiempo
+// sin hacer una syscall. Solo el kernel escribe; los lectores usan seq
+// como seqlock: si es impar o cambió durante la lectura, reintentar
+
+#define KDATA_PAGE_SIZE 4096
+
+typedef struct kdata_page {
+    volatile uint32_t seq;
+    uint32_t pid;            // proceso en ejecución
+    uint64_t ticks;          // ticks del timer desde el arranque (tick_hz por segundo)
+    uint64_t uptime_ms;      // base de tiempo monotónica, resolución de un tick
+    uint64_t tick_tsc;       // TSC leído en el último tick
+    uint8_t  hours;          // reloj de pared del RTC (UTC), binario
+    uint8_t  minutes;
+    uint8_t  seconds;
+    uint32_t tick_hz;        // frecuencia del tick (TICK_HZ del kernel)
+} kdata_page_t;
+
+#endif /* KDATA_PAGE_H */
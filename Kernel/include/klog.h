@@ -0,0 +1,33 @@
+#ifndef KLOG_H
+#define KLOG_H
+
+#include <stdint.h>
+
+// Log del kernel: printk formatea a un ring en memoria en vez de escribir
+// a pantalla; se lee con sys_dmesg. Los mensajes con nivel mayor al umbral
+// se descartan antes de formatear.
+
+#define KLOG_ERR   0
+#define KLOG_WARN  1
+#define KLOG_INFO  2
+#define KLOG_DEBUG 3
+
+#define KLOG_ENTRIES  128   // potencia de 2
+#define KLOG_LINE_MAX 112
+
+// Formatos: %d %i %u %x %p %s %c %% (prefijo l opcional en enteros)
+void printk(int level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Destino adicional para cada línea publicada (p. ej. el puerto serie).
+// Se llama desde printk: no puede bloquear
+typedef void (*klog_sink_fn)(const char *line, int len);
+void klog_set_sink(klog_sink_fn sink);
+
+int klog_get_level(void);
+void klog_set_level(int level);
+
+// Copia líneas completas "[ticks] N msg\n" desde *seq; avanza *seq y
+// devuelve los bytes escritos (0 = no hay más)
+int klog_read(uint64_t *seq, char *buf, int size);
+
+#endif
@@ -3,9 +3,17 @@
 
 #include <stdint.h>
 
+// Bits devueltos por memCpuFeatures
+#define MEM_FEAT_ERMS 0x1   // Enhanced REP MOVSB/STOSB
+#define MEM_FEAT_FSRM 0x2   // Fast Short REP MOV
+
 void * memset(void * destination, int32_t character, uint64_t length);
 void * memcpy(void * destination, const void * source, uint64_t length);
+void * memmove(void * destination, const void * source, uint64_t length);
+uint32_t memCpuFeatures(void);
+int memSelfCheck(void);
 int strcmp(const char *s1, const char *s2);
+int log2_bucket(uint64_t value, int shift, int buckets);
 
 char *cpuVendor(char *result);
 uint64_t getSeconds();
@@ -4,30 +4,37 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "sched.h"
+#include "spinlock.h"
+#include "poll.h"
+#include "uio.h"
 
 // Configuración del buffer circular y la tabla hash de pipes
 
 #define PIPE_DEFAULT_CAP 4096
-#define PIPE_CAP 4096
+#define PIPE_CAP 4096           // debe ser potencia de 2 (índices enmascarados)
+#define PIPE_MASK (PIPE_CAP - 1)
 #define PIPE_NAME_MAX 32
 #define PIPE_HASH_BUCKETS 16
 
-// Nodo de cola para procesos bloqueados por lectura/escritura
-typedef struct pipe_waiter {
-    pcb_t *proc;
-    struct pipe_waiter *next;
-} pipe_waiter_t;
-
-// Estructura interna de un pipe nominal del kernel
+// Estructura interna de un pipe nominal del kernel.
+// El ring es SPSC sin locks: head solo lo avanza el consumidor y tail solo el
+// productor (índices libres, size = tail - head). rd_lock/wr_lock serializan
+// lectores o escritores concurrentes del mismo extremo; con un único lector y
+// un único escritor nunca hay contención. lock (con IRQs off) solo se toma en
+// las fronteras vacío/lleno para manipular las colas de espera.
 typedef struct kpipe {
-    volatile uint32_t lock;        // spinlock para protección crítica
+    spinlock_t lock;             // protege colas de espera y contadores
+    spinlock_t rd_lock;          // exclusión entre consumidores
+    spinlock_t wr_lock;          // exclusión entre productores
     char name[PIPE_NAME_MAX];
     uint8_t buf[PIPE_CAP];
-    uint32_t r, w, size;        // ring buffer: read pos, write pos, current size
-    int readers, writers;        // contadores de FDs abiertos
+    volatile uint32_t head;      // próxima posición a leer (libre, sin módulo)
+    volatile uint32_t tail;      // próxima posición a escribir (libre, sin módulo)
+    volatile int readers, writers; // contadores de FDs abiertos
     bool unlinked;               // true si ya se hizo unlink
-    pipe_waiter_t *r_head, *r_tail;  // cola FIFO de lectores bloqueados
-    pipe_waiter_t *w_head, *w_tail;  // cola FIFO de escritores bloqueados
+    wait_queue_t readers_q;      // lectores bloqueados (FIFO)
+    wait_queue_t writers_q;      // escritores bloqueados (FIFO)
+    wait_queue_t pollers;        // procesos esperando en sys_poll
     struct kpipe *next_hash;     // siguiente en la tabla hash
 } kpipe_t;
 
@@ -35,8 +42,12 @@ typedef struct kpipe {
 int kpipe_create(const char* name, size_t capacity, kpipe_t **out);
 int kpipe_open(const char* name, bool for_read, bool for_write, kpipe_t **out);
 int kpipe_close(kpipe_t *p, bool was_read, bool was_write);
-int kpipe_read(kpipe_t *p, void *buf, int n);        // BLOQUEANTE
-int kpipe_write(kpipe_t *p, const void *buf, int n); // BLOQUEANTE
+int kpipe_read(kpipe_t *p, void *buf, int n, bool nonblock);        // BLOQUEANTE salvo nonblock
+int kpipe_write(kpipe_t *p, const void *buf, int n, bool nonblock); // BLOQUEANTE salvo nonblock
+// Vectoriales: todos los iovecs en una sola sección crítica del extremo
+int kpipe_readv(kpipe_t *p, const iovec_t *iov, int cnt, bool nonblock);
+int kpipe_writev(kpipe_t *p, const iovec_t *iov, int cnt, bool nonblock);
+int kpipe_poll(kpipe_t *p, bool rd, bool wr, wait_node_t *w);
 int kpipe_unlink(const char* name);
 
 #endif // PIPE_H
@@ -0,0 +1,33 @@
+#ifndef POLL_H
+#define POLL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sched.h"
+#include "wait_queue.h"
+
+// Multiplexación de file descriptors (sys_poll)
+
+#define POLLIN    0x0001   // hay datos para leer
+#define POLLOUT   0x0004   // se puede escribir sin bloquear
+#define POLLERR   0x0008   // error (p. ej. pipe sin lectores)
+#define POLLHUP   0x0010   // el otro extremo se cerró (EOF)
+#define POLLNVAL  0x0020   // fd inválido
+
+#define POLL_MAX_FDS 16
+
+// Debe coincidir con la definición de userland
+typedef struct pollfd {
+    int fd;
+    int16_t events;
+    int16_t revents;
+} pollfd_t;
+
+// Cada recurso expone una wait_queue_t de poll. sys_poll registra en ella un
+// wait_node_t por fd (viven en el stack del proceso, sin asignar memoria) y
+// los recursos la vacían con wait_queue_wake_all() cuando cambia su estado.
+
+int  kpoll(pollfd_t *fds, int n, int timeout_ms);
+void poll_cancel(pcb_t *proc);   // Desregistra a un proceso que muere en poll
+
+#endif // POLL_H
@@ -4,6 +4,7 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include "wait_queue.h"
 
 struct wait_result;
 struct fd_table;
@@ -21,7 +22,14 @@ typedef enum {
 #define MIN_PRIO          0
 #define HIGHEST_PRIO      (MAX_PRIOS - 1)
 #define DEFAULT_PRIO      2
-#define TIME_SLICE_TICKS  5
+#define TIME_SLICE_US     20000   // quantum de DEFAULT_PRIO; ver quantum_us[] en sched.c
+
+// 1: quien cede la CPU antes de agotar su slice (yield o bloqueo) retoma
+// lo que le quedaba; 0: cada vez que vuelve a correr arranca un quantum
+// completo. Se puede cambiar al compilar: make SCHED_KEEP_SLICE=0
+#ifndef SCHED_KEEP_SLICE
+#define SCHED_KEEP_SLICE  1
+#endif
 
 typedef struct regs_t {
     uint64_t r15;
@@ -57,6 +65,7 @@ typedef struct pcb_t {
     int parent_pid;
     bool fg;
     int ticks_left;
+    int slice_left;   // slice sin usar según los ticks del timer (los yields no lo tocan)
     struct pcb_t *next;
     /* Campos adicionales para administración interna */
     struct pcb_t *prev;
@@ -80,6 +89,16 @@ typedef struct pcb_t {
     bool zombie_reapable;
     struct fd_table *fd_table;
     int aging_ticks;
+    wait_node_t wait_node;             // nodo para la cola donde está bloqueado
+    bool sem_handoff;                  // ksem_post le pasó una unidad al despertarlo
+    wait_node_t *poll_nodes;           // nodos registrados por sys_poll (en su stack)
+    int poll_count;
+    uint64_t wake_tick;                // tick de timeout armado (0 = ninguno)
+    struct pcb_t *timer_next;
+    uintptr_t futex_addr;              // dirección esperada en futex_wait
+    void *user_tls;                    // estado por proceso de userland (de sys_tls_alloc)
+    void (*exit_hook)(void);           // userland: se llama al retornar de entry
+    struct io_ring *io_ring;           // ring de sys_io_ring_setup (memoria de userland)
 } pcb_t;
 
 typedef struct proc_info_t {
@@ -99,6 +118,7 @@ void     sched_init(void);
 void     sched_start(void);
 bool     sched_is_enabled(void);
 uint64_t schedule(uint64_t cur_rsp);
+uint64_t schedule_yield(uint64_t cur_rsp);
 int      proc_create(void (*entry)(int, char **), int argc, char **argv,
                     int prio, bool fg, const char *name);
 void     proc_exit(int code);
@@ -117,5 +137,9 @@ pcb_t   *sched_current(void);
 void     sched_enqueue(pcb_t *proc);
 void     sched_remove(pcb_t *proc);
 void     sched_force_yield(void);
+void     sched_preempt_point(void);
+int      sched_quantum_ticks(int prio);
+void     sched_arm_timeout(pcb_t *proc, uint64_t wake_tick);
+void     sched_cancel_timeout(pcb_t *proc);
 
 #endif
@@ -5,23 +5,12 @@
 #include <stdint.h>
 #include "sched.h"
 #include "spinlock.h"
+#include "wait_queue.h"
 
 // Parámetros globales del sistema de semáforos nombrados
 
 #define KSEM_NAME_MAX     32
 #define KSEM_HASH_BUCKETS 32
-#define KSEM_HANDLE_MAX   128
-
-// Cola de procesos bloqueados sobre el semáforo
-typedef struct sem_waiter {
-    pcb_t *proc;
-    struct sem_waiter *next;
-} sem_waiter_t;
-
-typedef struct wait_queue {
-    sem_waiter_t *head;
-    sem_waiter_t *tail;
-} wait_queue_t;
 
 // Semáforo kernel-space compartido entre procesos
 typedef struct ksem {
@@ -31,7 +20,7 @@ typedef struct ksem {
     unsigned int refcount;
     bool unlinked;
     bool destroying;
-    wait_queue_t waiters;
+    wait_queue_t waiters;        // procesos bloqueados (nodos embebidos en el PCB)
     struct ksem *hash_next;
 } ksem_t;
 
@@ -40,6 +29,5 @@ int ksem_wait(ksem_t *sem);
 int ksem_post(ksem_t *sem);
 int ksem_close(ksem_t *sem);
 int ksem_unlink(const char *name);
-void ksem_remove_waiters_for(pcb_t *proc);
 
 #endif
@@ -0,0 +1,23 @@
+#ifndef SERIAL_H
+#define SERIAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct wait_node;
+
+// UART 16550 en COM1 (0x3F8, IRQ4), 115200 8N1. La transmisión sale de un
+// ring que vacía la interrupción THRE, así escribir no espera al puerto.
+// Los bytes se envían tal cual (sin traducir \n), para capturarlos con
+// qemu -serial stdio o -serial file:...
+
+void serial_init(void);
+bool serial_present(void);
+void serial_handler(void);
+
+// Bloqueantes salvo nonblock (E_AGAIN si no hay lugar/datos)
+int serial_write(const void *buf, int n, bool nonblock);
+int serial_read(void *buf, int n, bool nonblock);
+int serial_poll(struct wait_node *w);
+
+#endif
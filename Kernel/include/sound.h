@@ -2,8 +2,19 @@
 #define SOUND_H
 #include <stdint.h>
 
+// Misma disposición que NoteType de userland
+typedef struct {
+    int32_t freq;       // Hz; 0 = silencio
+    int32_t duration;   // ms
+} sound_note_t;
+
 void stopSpeaker();
 void beep(uint32_t freq, uint64_t duration);
 void triggerSpeaker(uint32_t frequence);
 
+// Secuenciador asíncrono: el timer avanza las notas encoladas
+int sound_enqueue(const sound_note_t *notes, int count);
+void sound_cancel(void);
+void sound_tick(void);
+
 #endif
@@ -54,7 +54,7 @@
  * value == 0: desbloqueado
  * value == 1: bloqueado
  */
-typedef struct {
+typedef struct spinlock {
     volatile int value;
 } spinlock_t;
 
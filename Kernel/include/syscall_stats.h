@@ -0,0 +1,32 @@
+#ifndef SYSCALL_STATS_H
+#define SYSCALL_STATS_H
+
+#include <stdint.h>
+
+// Estadísticas por syscall que exporta sys_syscall_stats
+
+#define SYSCALL_NAME_MAX      16
+#define SYSCALL_HIST_BUCKETS  16
+#define SYSCALL_HIST_SHIFT    6   // bucket 0: < 2^7 ciclos; bucket i: [2^(i+6), 2^(i+7))
+
+// Metadatos de la tabla de syscalls
+#define SYSCALL_F_BLOCKS    0x1   // puede bloquear: los ciclos incluyen la espera
+#define SYSCALL_F_NORETURN  0x2   // no vuelve al llamador (no se mide latencia)
+#define SYSCALL_F_LEGACY    0x4   // interfaz vieja de una sola tecla/carácter
+
+// op de sys_syscall_stats
+#define SYSCALL_STATS_READ   0
+#define SYSCALL_STATS_RESET  1
+
+typedef struct syscall_stat {
+    uint32_t number;
+    uint8_t  arity;
+    uint8_t  flags;
+    char     name[SYSCALL_NAME_MAX];
+    uint64_t count;
+    uint64_t cycles;       // suma de ciclos de TSC de las llamadas que volvieron
+    uint64_t max_cycles;
+    uint32_t hist[SYSCALL_HIST_BUCKETS];
+} syscall_stat_t;
+
+#endif /* SYSCALL_STATS_H */
@@ -4,6 +4,10 @@
 #include <stdint.h>
 #include "sched.h"
 #include "mm_stats.h"
+#include "io_ring.h"
+#include "uio.h"
+
+struct pollfd;
 
 // Declaraciones de las llamadas al sistema expuestas a userland
 
@@ -11,6 +15,8 @@ uint64_t sys_getpid(void);
 uint64_t sys_yield(void);
 uint64_t sys_exit(int code);
 uint64_t sys_nice(int pid, int new_prio);
+void    *sys_tls_get(void);
+void    *sys_tls_alloc(size_t size, void (*exit_hook)(void));
 uint64_t sys_block(int pid);
 uint64_t sys_unblock(int pid);
 uint64_t sys_wait_pid(int pid, int *status);
@@ -21,20 +27,47 @@ int      sys_sem_wait(int sem_id);
 int      sys_sem_post(int sem_id);
 int      sys_sem_close(int sem_id);
 int      sys_sem_unlink(const char *name);
-void     sem_cleanup_process_handles(int pid);  // Cleanup en proc_exit
 int      sys_mm_get_stats(mm_stats_t *stats);
 
 // Pipes (Hito 5)
-int      sys_pipe_open(const char *name, int flags);  // flags: 1=R, 2=W, 3=RW
+int      sys_pipe_open(const char *name, int flags);  // flags: 1=R, 2=W, 3=RW, |4=O_NONBLOCK
 int      sys_pipe_close(int fd);
 int      sys_pipe_read(int fd, void *buf, int n);
 int      sys_pipe_write(int fd, const void *buf, int n);
 int      sys_pipe_unlink(const char *name);
 
+// Puerto serie COM1 como fd (flags: 1=R, 2=W, 3=RW, |4=O_NONBLOCK)
+int      sys_serial_open(int flags);
+
 // FD genéricos
 int      sys_read(int fd, void *buf, int n);
 int      sys_write(int fd, const void *buf, int n);
+int      sys_readv(int fd, const iovec_t *iov, int cnt);   // cnt <= IOV_MAX
+int      sys_writev(int fd, const iovec_t *iov, int cnt);
 int      sys_close(int fd);
 int      sys_dup2(int oldfd, int newfd);
+int      sys_poll(struct pollfd *fds, int n, int timeout_ms);
+int      sys_fcntl(int fd, int cmd, int arg);
+int      sys_ioctl(int fd, int request, int arg);
+
+// Futex: solo se llama con contención (fast path atómico en userland)
+int      sys_futex_wait(volatile uint32_t *addr, uint32_t expected);
+int      sys_futex_wake(volatile uint32_t *addr, int n);
+
+// Benchmark de las rutinas de memoria de lib.c (ciclos de TSC)
+#define MEM_BENCH_MEMCPY   0
+#define MEM_BENCH_MEMSET   1
+#define MEM_BENCH_MEMMOVE  2
+#define MEM_BENCH_BYTES    3   // copia byte a byte, como referencia
+#define MEM_BENCH_FEATURES 4
+uint64_t sys_mem_bench(int op, uint64_t size, uint64_t iters);
+
+// Ring de envío/completado por proceso (ver io_ring.h)
+int      sys_io_ring_setup(io_ring_t *ring);
+int      sys_io_ring_enter(int to_submit);
+
+// Log del kernel (ver klog.h)
+int      sys_dmesg(uint64_t *seq, char *buf, int size);
+int      sys_klog_level(int level);
 
 #endif
@@ -2,11 +2,28 @@
 #define _TIME_H_
 
 
+#include <stdint.h>
+
+// Frecuencia del tick (timer del LAPIC o PIT), fija al compilar:
+// make clean all TICK_HZ=1000
+#ifndef TICK_HZ
+#define TICK_HZ 250
+#endif
+
+#if TICK_HZ < 100 || TICK_HZ > 1000
+#error "TICK_HZ tiene que estar entre 100 y 1000"
+#endif
+
+#define PIT_HZ 1193182
+
+void timer_init(void);
 void timer_handler();
-int ticks_elapsed();
+uint64_t ticks_elapsed();
+uint64_t ms_to_ticks(int ms);
+uint64_t us_to_ticks(uint64_t us);
 int seconds_elapsed();
-int ms_elapsed();
+uint64_t ms_elapsed();
 void timer_wait(int delta);
 void sleep(int millis);
 
-#endif
\ No newline at end of file
+#endif
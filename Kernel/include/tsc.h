@@ -0,0 +1,14 @@
+#ifndef TSC_H
+#define TSC_H
+
+#include <stdint.h>
+
+// Lectura del contador de ciclos; lfence evita que se adelante a las
+// instrucciones previas y quede fuera de la región medida
+static inline uint64_t rdtsc(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("lfence\n\trdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+    return ((uint64_t)hi << 32) | lo;
+}
+
+#endif /* TSC_H */
@@ -2,9 +2,11 @@
 
 #include <stdbool.h>
 #include <stdint.h>
+#include "uio.h"
 
 struct tty;
 typedef struct tty tty_t;
+struct wait_node;
 
 /**
  * @brief Obtiene la instancia singleton de la TTY por defecto
@@ -13,16 +15,35 @@ typedef struct tty tty_t;
 tty_t *tty_default(void);
 
 /**
- * @brief Lee datos del buffer de entrada de la TTY (bloqueante)
+ * @brief Lee datos del buffer de entrada de la TTY (bloqueante salvo nonblock)
  * @param t Puntero a la TTY
  * @param buf Buffer de destino
  * @param n Número de bytes a leer
+ * @param nonblock Si es true devuelve E_AGAIN en lugar de bloquear
  * @return Número de bytes leídos, o -1 en error
  */
-int tty_read(tty_t *t, void *buf, int n);
+int tty_read(tty_t *t, void *buf, int n, bool nonblock);
+
+/**
+ * @brief Versión vectorial de tty_read: llena los iovecs en orden
+ * @return Bytes leídos en total, o -1 en error
+ */
+int tty_readv(tty_t *t, const iovec_t *iov, int cnt, bool nonblock);
+
+/**
+ * @brief Consulta si hay entrada disponible (para sys_poll)
+ * @param t Puntero a la TTY
+ * @param w Nodo a registrar en la cola de poll, o NULL para solo consultar
+ * @return POLLIN si hay datos o EOF pendiente, 0 si no
+ */
+int tty_poll(tty_t *t, struct wait_node *w);
 
 /**
  * @brief Escribe datos a la salida de la TTY
+ *
+ * Los tramos de texto se dibujan de una pasada; las secuencias ANSI SGR
+ * (ESC [ ... m: 0, 30-37, 39, 40-47, 49, 90-97, 100-107, 38;2;r;g;b,
+ * 48;2;r;g;b) cambian el color y el estado persiste entre llamadas.
  * @param t Puntero a la TTY
  * @param buf Buffer de origen
  * @param n Número de bytes a escribir
@@ -30,6 +51,12 @@ int tty_read(tty_t *t, void *buf, int n);
  */
 int tty_write(tty_t *t, const void *buf, int n);
 
+/**
+ * @brief Versión vectorial de tty_write, en una sola syscall
+ * @return Bytes escritos en total, o -1 en error
+ */
+int tty_writev(tty_t *t, const iovec_t *iov, int cnt);
+
 /**
  * @brief Cierra la TTY (no-op para compatibilidad)
  * @param t Puntero a la TTY
@@ -37,6 +64,24 @@ int tty_write(tty_t *t, const void *buf, int n);
  */
 int tty_close(tty_t *t);
 
+// Flags de la disciplina de línea (TTY_SETFLAGS)
+#define TTY_ICANON 0x1   // edición en el kernel, lecturas línea por línea
+#define TTY_ECHO   0x2   // eco de lo tecleado
+#define TTY_RAW    0     // cada tecla se entrega al instante, sin eco
+
+// Requests de tty_ioctl / sys_ioctl
+#define TTY_GETFLAGS 1
+#define TTY_SETFLAGS 2
+
+/**
+ * @brief Consulta o cambia el modo de la disciplina de línea
+ * @param t Puntero a la TTY
+ * @param request TTY_GETFLAGS o TTY_SETFLAGS
+ * @param arg Nuevos flags (TTY_SETFLAGS)
+ * @return Flags actuales (GET), 0 (SET) o E_INVAL
+ */
+int tty_ioctl(tty_t *t, int request, int arg);
+
 /**
  * @brief Encola un carácter en el buffer de entrada de la TTY
  * @param t Puntero a la TTY
@@ -0,0 +1,15 @@
+#ifndef UIO_H
+#define UIO_H
+
+#include <stdint.h>
+
+// Vector de buffers para sys_readv/sys_writev
+
+#define IOV_MAX 16
+
+typedef struct iovec {
+    void    *iov_base;
+    uint64_t iov_len;
+} iovec_t;
+
+#endif /* UIO_H */
@@ -11,6 +11,12 @@ typedef struct {
 extern Color WHITE;
 extern Color BLACK;
 
+void vDriver_init(void);
+void vDriver_flush(void);
+void vDriver_tick(void);
+void vDriver_batchBegin(void);
+void vDriver_batchEnd(void);
+
 void plusScale();
 void minusScale();
 uint16_t getRealCharWidth();
@@ -18,6 +24,7 @@ uint16_t getRealCharHeight();
 
 void vDriver_prints(const char *str, Color fnt, Color bgd);
 void vDriver_print(char c, Color fnt, Color bgd);
+void vDriver_write(const char *str, int n, Color fnt, Color bgd);
 void vDriver_newline();
 void vDriver_backspace(Color fnt, Color bgd);
 void vDriver_clear();
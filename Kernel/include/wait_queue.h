@@ -0,0 +1,39 @@
+#ifndef WAIT_QUEUE_H
+#define WAIT_QUEUE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Colas de espera genéricas (pipes, TTY, semáforos, poll).
+// Los nodos son intrusivos: cada PCB embebe uno porque un proceso bloqueado
+// espera en una sola cola a la vez, así que bloquear no asigna memoria.
+
+struct pcb_t;
+struct spinlock;
+struct wait_queue;
+
+typedef struct wait_node {
+    struct pcb_t *proc;
+    struct wait_node *next;
+    struct wait_queue *queue;    // cola donde está encolado (NULL = ninguna)
+} wait_node_t;
+
+typedef struct wait_queue {
+    wait_node_t *head;
+    wait_node_t *tail;
+    struct spinlock *lock;       // lock del recurso dueño (NULL = solo IRQs off)
+} wait_queue_t;
+
+// Todas salvo wait_queue_detach requieren el lock de la cola tomado
+void          wait_queue_init(wait_queue_t *q, struct spinlock *lock);
+bool          wait_queue_empty(const wait_queue_t *q);
+void          wait_queue_add(wait_queue_t *q, wait_node_t *node, struct pcb_t *proc);
+bool          wait_queue_remove(wait_queue_t *q, wait_node_t *node);
+struct pcb_t *wait_queue_pop(wait_queue_t *q);
+struct pcb_t *wait_queue_wake_one(wait_queue_t *q);
+int           wait_queue_wake_all(wait_queue_t *q);
+
+// Saca el nodo de la cola en la que esté, tomando su lock (kill, poll)
+void          wait_queue_detach(wait_node_t *node);
+
+#endif // WAIT_QUEUE_H
@@ -53,5 +53,6 @@ void exception_handler(int exception, const uint64_t register_data[17]) {
             vDriver_prints("   ",white,black);
     }
 
+    vDriver_flush();  // el volcado tiene que verse aunque no llegue otro tick
     reset();
 }
@@ -2,6 +2,8 @@
 #include "idtLoader.h"
 #include "defs.h"
 #include "interrupts.h"
+#include "apic.h"
+#include "time.h"
 
 #pragma pack(push) /* Push de la alineación actual */
 #pragma pack(1)    /* Alinear las siguiente estructuras a 1 byte */
@@ -19,7 +21,20 @@ typedef struct
 
 DESCR_INT *idt = (DESCR_INT *)0; // IDT de 255 entradas
 
+// MSRs de SYSCALL
+#define MSR_EFER   0xC0000080
+#define MSR_STAR   0xC0000081
+#define MSR_LSTAR  0xC0000082
+#define MSR_SFMASK 0xC0000084
+
+#define EFER_SCE   0x1
+// IF, DF, TF y AC se limpian al entrar, como en la compuerta de int 0x80
+#define SYSCALL_FLAGS_MASK ((1 << 9) | (1 << 10) | (1 << 8) | (1 << 18))
+
 static void setup_IDT_entry(int index, uint64_t offset);
+static void setup_syscall_msrs(void);
+static uint64_t rdmsr(uint32_t msr);
+static void wrmsr(uint32_t msr, uint64_t value);
 
 void load_idt()
 {
@@ -29,17 +44,29 @@ void load_idt()
   // Load IDT
   setup_IDT_entry(0x21, (uint64_t)&interrupt_keyboardHandler);
   setup_IDT_entry(0x20, (uint64_t)&irq_timer_handler);
+  setup_IDT_entry(0x24, (uint64_t)&interrupt_serialHandler);
+  setup_IDT_entry(0x27, (uint64_t)&interrupt_spurious);
+  setup_IDT_entry(APIC_SPURIOUS_VECTOR, (uint64_t)&interrupt_spurious);
 
   // Syscall
   setup_IDT_entry(0x80, (uint64_t)&interrupt_systemCall);
+  setup_IDT_entry(0x81, (uint64_t)&interrupt_forceSchedule);
+  setup_syscall_msrs();
 
   // Exceptions
   setup_IDT_entry(0x00, (uint64_t)&exception_zeroDiv);
   setup_IDT_entry(0x06, (uint64_t)&exception_invalidOp);
 
   // Load IDTR
-  picMasterMask(0xFC);
-  picSlaveMask(0xFF);
+  timer_init();
+
+  // LAPIC/IO-APIC si Pure64 los encontró; si no, 8259 con IRQ0 timer,
+  // IRQ1 teclado e IRQ4 COM1
+  if (!apic_init())
+  {
+    picMasterMask(0xEC);
+    picSlaveMask(0xFF);
+  }
 
   // Start Interruptions
   _sti();
@@ -55,3 +82,25 @@ static void setup_IDT_entry(int index, uint64_t offset)
   idt[index].cero = 0;
   idt[index].other_cero = (uint64_t)0;
 }
+
+static uint64_t rdmsr(uint32_t msr)
+{
+  uint32_t lo, hi;
+  __asm__ volatile("rdmsr" : "=a"(lo), "=d"(hi) : "c"(msr));
+  return ((uint64_t)hi << 32) | lo;
+}
+
+static void wrmsr(uint32_t msr, uint64_t value)
+{
+  __asm__ volatile("wrmsr" : : "c"(msr), "a"((uint32_t)value), "d"((uint32_t)(value >> 32)));
+}
+
+// SYSCALL carga CS = STAR[47:32] y SS = CS + 8 (0x08 / 0x10 en la GDT de
+// Pure64). El retorno no usa SYSRET, así que STAR[63:48] queda en cero
+static void setup_syscall_msrs(void)
+{
+  wrmsr(MSR_STAR, (uint64_t)0x08 << 32);
+  wrmsr(MSR_LSTAR, (uint64_t)&interrupt_fastSystemCall);
+  wrmsr(MSR_SFMASK, SYSCALL_FLAGS_MASK);
+  wrmsr(MSR_EFER, rdmsr(MSR_EFER) | EFER_SCE);
+}
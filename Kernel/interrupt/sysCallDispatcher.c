@@ -7,11 +7,16 @@
 #include <sched.h>
 #include <syscalls.h>
 #include <tty.h>
+#include <tsc.h>
+#include <syscall_stats.h>
+#include <kdata.h>
+#include <irqoff.h>
+#include <irqtrace.h>
 
 #define STDIN 0
 #define STDOUT 1
 #define STDERR 2
-#define SYS_CALLS_QTY 47
+#define SYS_CALLS_QTY 70
 
 extern uint8_t hasregisterInfo;
 extern const uint64_t registerInfo[17];
@@ -20,6 +25,23 @@ extern int _hlt();
 extern Color WHITE;
 extern Color BLACK;
 
+// Contadores por syscall; el dispatcher corre con IF=0, no hace falta lock
+typedef struct syscall_counter {
+    uint64_t count;
+    uint64_t cycles;
+    uint64_t max_cycles;
+    uint32_t hist[SYSCALL_HIST_BUCKETS];
+} syscall_counter_t;
+
+static syscall_counter_t syscall_counters[SYS_CALLS_QTY];
+
+// Un sitio de IF=0 por syscall; el nombre se toma de la tabla al primer uso
+static irqoff_site_t syscall_sites[SYS_CALLS_QTY];
+
+static Color unpack_color(uint64_t rgb);
+static void syscall_account(syscall_counter_t *counter, uint64_t cycles);
+static uint64_t sys_syscall_stats(int op, syscall_stat_t *out, int max);
+
 // Versión legacy de lectura para FD 0 (TTY)
 static uint64_t sys_read_tty(uint64_t fd, char *buff)
 {
@@ -28,7 +50,7 @@ static uint64_t sys_read_tty(uint64_t fd, char *buff)
         return -1;
     }
 
-    int read = tty_read(tty_default(), buff, 1);
+    int read = tty_read(tty_default(), buff, 1, false);
     if (read <= 0) {
         buff[0] = 0;
     }
@@ -84,15 +106,32 @@ static void sys_drawRectangle(int x, int y, int x2, int y2, Color color)
     vDriver_drawRectangle(x, y, x2, y2, color);
 }
 
+// begin != 0 abre un batch de dibujo; 0 lo cierra y vuelca a pantalla
+static uint64_t sys_video_batch(int begin)
+{
+    if (begin)
+    {
+        vDriver_batchBegin();
+    }
+    else
+    {
+        vDriver_batchEnd();
+    }
+    return 0;
+}
+
 static void sys_sleep(int ms)
 {
     if (ms > 0)
     {
-        int start_ms = ms_elapsed();
+        // _hlt habilita interrupciones: la espera no cuenta como tramo con IF=0
+        irqoff_site_t *site = irqoff_pause();
+        uint64_t start_ms = ms_elapsed();
         do
         {
             _hlt();
-        } while (ms_elapsed() - start_ms < ms);
+        } while (ms_elapsed() - start_ms < (uint64_t)ms);
+        irqoff_resume(site);
     }
 }
 
@@ -165,10 +204,16 @@ static uint64_t sys_playSpeaker(uint32_t frequence, uint64_t duration)
 
 static uint64_t sys_stopSpeaker()
 {
-    stopSpeaker();
+    sound_cancel();
     return 1;
 }
 
+// Encola la melodía y retorna enseguida; el timer la reproduce
+static uint64_t sys_play_melody(const sound_note_t *notes, int count)
+{
+    return (uint64_t)(int64_t)sound_enqueue(notes, count);
+}
+
 static uint64_t sys_malloc(size_t size)
 {
     return (uint64_t)mm_malloc(size);
@@ -208,125 +253,533 @@ static uint64_t sys_kill(int pid)
     return proc_kill(pid);
 }
 
-uint64_t syscall_dispatcher(uint64_t rdi, uint64_t rsi, uint64_t rdx, uint64_t rcx, uint64_t r8, uint64_t r9, uint64_t rax)
+// Color empaquetado como 0xRRGGBB
+static Color unpack_color(uint64_t rgb)
 {
-    // Nota: rcx contiene el valor de r10 desde userland (4to parámetro de syscalls)
-    uint64_t r10 = rcx;  // Renombrar para claridad en el código
-    uint8_t r, g, b;
     Color color;
-    switch (rax)
+    color.r = (rgb >> 16) & 0xFF;
+    color.g = (rgb >> 8) & 0xFF;
+    color.b = rgb & 0xFF;
+    return color;
+}
+
+static void syscall_account(syscall_counter_t *counter, uint64_t cycles)
+{
+    counter->cycles += cycles;
+    if (cycles > counter->max_cycles)
+    {
+        counter->max_cycles = cycles;
+    }
+    counter->hist[log2_bucket(cycles, SYSCALL_HIST_SHIFT, SYSCALL_HIST_BUCKETS)]++;
+}
+
+// Un adaptador por syscall: convierte los registros a los tipos de la implementación
+#define SC_ARGS __attribute__((unused)) uint64_t a0, __attribute__((unused)) uint64_t a1, \
+                __attribute__((unused)) uint64_t a2, __attribute__((unused)) uint64_t a3, \
+                __attribute__((unused)) uint64_t a4, __attribute__((unused)) uint64_t a5
+
+static uint64_t sc_read_tty(SC_ARGS)
+{
+    return sys_read_tty(a0, (char *)a1);
+}
+
+static uint64_t sc_write_tty(SC_ARGS)
+{
+    return sys_write_tty(a0, (char)a1);
+}
+
+static uint64_t sc_clear(SC_ARGS)
+{
+    return sys_clear();
+}
+
+static uint64_t sc_hours(SC_ARGS)
+{
+    return sys_getHours();
+}
+
+static uint64_t sc_minutes(SC_ARGS)
+{
+    return sys_getMinutes();
+}
+
+static uint64_t sc_seconds(SC_ARGS)
+{
+    return sys_getSeconds();
+}
+
+static uint64_t sc_scr_height(SC_ARGS)
+{
+    return sys_getScrHeight();
+}
+
+static uint64_t sc_scr_width(SC_ARGS)
+{
+    return sys_getScrWidth();
+}
+
+static uint64_t sc_draw_rect(SC_ARGS)
+{
+    sys_drawRectangle(a0, a1, a2, a3, unpack_color(a4));
+    return 1;
+}
+
+static uint64_t sc_sleep(SC_ARGS)
+{
+    sys_sleep(a0);
+    return 1;
+}
+
+static uint64_t sc_reg_info(SC_ARGS)
+{
+    return sys_registerInfo((uint64_t *)a0);
+}
+
+static uint64_t sc_printmem(SC_ARGS)
+{
+    return sys_printmem((uint64_t *)a0);
+}
+
+static uint64_t sc_pixel_plus(SC_ARGS)
+{
+    return sys_pixelPlus();
+}
+
+static uint64_t sc_pixel_minus(SC_ARGS)
+{
+    return sys_pixelMinus();
+}
+
+static uint64_t sc_beep(SC_ARGS)
+{
+    return sys_playSpeaker((uint32_t)a0, a1);
+}
+
+static uint64_t sc_stop_speaker(SC_ARGS)
+{
+    return sys_stopSpeaker();
+}
+
+static uint64_t sc_draw_cursor(SC_ARGS)
+{
+    return sys_drawCursor();
+}
+
+static uint64_t sc_write_color(SC_ARGS)
+{
+    return sys_writeColor(a0, (char)a1, unpack_color(a2));
+}
+
+static uint64_t sc_malloc(SC_ARGS)
+{
+    return sys_malloc((size_t)a0);
+}
+
+static uint64_t sc_free(SC_ARGS)
+{
+    return sys_free((void *)a0);
+}
+
+static uint64_t sc_mem_info(SC_ARGS)
+{
+    return sys_mem_info((memory_info_t *)a0);
+}
+
+static uint64_t sc_getpid(SC_ARGS)
+{
+    return sys_getpid();
+}
+
+static uint64_t sc_create_proc(SC_ARGS)
+{
+    return sys_create_process((void (*)(int, char **))a0, (int)a1, (char **)a2, (const char *)a3, (uint8_t)a4);
+}
+
+static uint64_t sc_kill(SC_ARGS)
+{
+    return sys_kill((int)a0);
+}
+
+static uint64_t sc_block(SC_ARGS)
+{
+    return sys_block((int)a0);
+}
+
+static uint64_t sc_unblock(SC_ARGS)
+{
+    return sys_unblock((int)a0);
+}
+
+static uint64_t sc_nice(SC_ARGS)
+{
+    return sys_nice((int)a0, (uint8_t)a1);
+}
+
+static uint64_t sc_yield(SC_ARGS)
+{
+    return sys_yield();
+}
+
+static uint64_t sc_wait_pid(SC_ARGS)
+{
+    return sys_wait_pid((int)a0, (int *)a1);
+}
+
+static uint64_t sc_exit(SC_ARGS)
+{
+    return sys_exit((int)a0);
+}
+
+static uint64_t sc_proc_snapshot(SC_ARGS)
+{
+    return sys_proc_snapshot((proc_info_t *)a0, a1);
+}
+
+static uint64_t sc_sem_open(SC_ARGS)
+{
+    return sys_sem_open((const char *)a0, (unsigned int)a1);
+}
+
+static uint64_t sc_sem_wait(SC_ARGS)
+{
+    return sys_sem_wait((int)a0);
+}
+
+static uint64_t sc_sem_post(SC_ARGS)
+{
+    return sys_sem_post((int)a0);
+}
+
+static uint64_t sc_sem_close(SC_ARGS)
+{
+    return sys_sem_close((int)a0);
+}
+
+static uint64_t sc_sem_unlink(SC_ARGS)
+{
+    return sys_sem_unlink((const char *)a0);
+}
+
+static uint64_t sc_pipe_open(SC_ARGS)
+{
+    return sys_pipe_open((const char *)a0, (int)a1);
+}
+
+static uint64_t sc_pipe_close(SC_ARGS)
+{
+    return sys_pipe_close((int)a0);
+}
+
+static uint64_t sc_pipe_read(SC_ARGS)
+{
+    return sys_pipe_read((int)a0, (void *)a1, (int)a2);
+}
+
+static uint64_t sc_pipe_write(SC_ARGS)
+{
+    return sys_pipe_write((int)a0, (const void *)a1, (int)a2);
+}
+
+static uint64_t sc_pipe_unlink(SC_ARGS)
+{
+    return sys_pipe_unlink((const char *)a0);
+}
+
+static uint64_t sc_read(SC_ARGS)
+{
+    return sys_read((int)a0, (void *)a1, (int)a2);
+}
+
+static uint64_t sc_write(SC_ARGS)
+{
+    return sys_write((int)a0, (const void *)a1, (int)a2);
+}
+
+static uint64_t sc_close(SC_ARGS)
+{
+    return sys_close((int)a0);
+}
+
+static uint64_t sc_dup2(SC_ARGS)
+{
+    return sys_dup2((int)a0, (int)a1);
+}
+
+static uint64_t sc_create_proc_ex(SC_ARGS)
+{
+    return sys_create_process_ex((void (*)(int, char **))a0, (int)a1, (char **)a2, (const char *)a3, (uint8_t)a4, (int)a5);
+}
+
+static uint64_t sc_mm_stats(SC_ARGS)
+{
+    return sys_mm_get_stats((mm_stats_t *)a0);
+}
+
+static uint64_t sc_wait_children(SC_ARGS)
+{
+    return sys_wait_children((int *)a0);
+}
+
+static uint64_t sc_poll(SC_ARGS)
+{
+    return sys_poll((struct pollfd *)a0, (int)a1, (int)a2);
+}
+
+static uint64_t sc_fcntl(SC_ARGS)
+{
+    return sys_fcntl((int)a0, (int)a1, (int)a2);
+}
+
+static uint64_t sc_futex_wait(SC_ARGS)
+{
+    return sys_futex_wait((volatile uint32_t *)a0, (uint32_t)a1);
+}
+
+static uint64_t sc_futex_wake(SC_ARGS)
+{
+    return sys_futex_wake((volatile uint32_t *)a0, (int)a1);
+}
+
+static uint64_t sc_video_batch(SC_ARGS)
+{
+    return sys_video_batch((int)a0);
+}
+
+static uint64_t sc_tls_get(SC_ARGS)
+{
+    return (uint64_t)sys_tls_get();
+}
+
+static uint64_t sc_tls_alloc(SC_ARGS)
+{
+    return (uint64_t)sys_tls_alloc((size_t)a0, (void (*)(void))a1);
+}
+
+static uint64_t sc_mem_bench(SC_ARGS)
+{
+    return sys_mem_bench((int)a0, a1, a2);
+}
+
+static uint64_t sc_play_melody(SC_ARGS)
+{
+    return sys_play_melody((const sound_note_t *)a0, (int)a1);
+}
+
+static uint64_t sc_dmesg(SC_ARGS)
+{
+    return sys_dmesg((uint64_t *)a0, (char *)a1, (int)a2);
+}
+
+static uint64_t sc_klog_level(SC_ARGS)
+{
+    return sys_klog_level((int)a0);
+}
+
+static uint64_t sc_serial_open(SC_ARGS)
+{
+    return sys_serial_open((int)a0);
+}
+
+static uint64_t sc_ioctl(SC_ARGS)
+{
+    return sys_ioctl((int)a0, (int)a1, (int)a2);
+}
+
+// Syscall vacía: mide solo el costo de entrada y salida
+static uint64_t sc_nop(SC_ARGS)
+{
+    return 0;
+}
+
+// Dirección de la página compartida de PID/tiempo (ver kdata_page.h)
+static uint64_t sc_kdata(SC_ARGS)
+{
+    return (uint64_t)kdata_page();
+}
+
+static uint64_t sc_io_ring_setup(SC_ARGS)
+{
+    return sys_io_ring_setup((io_ring_t *)a0);
+}
+
+static uint64_t sc_io_ring_enter(SC_ARGS)
+{
+    return sys_io_ring_enter((int)a0);
+}
+
+static uint64_t sc_readv(SC_ARGS)
+{
+    return sys_readv((int)a0, (const iovec_t *)a1, (int)a2);
+}
+
+static uint64_t sc_writev(SC_ARGS)
+{
+    return sys_writev((int)a0, (const iovec_t *)a1, (int)a2);
+}
+
+static uint64_t sc_syscall_stats(SC_ARGS)
+{
+    return sys_syscall_stats((int)a0, (syscall_stat_t *)a1, (int)a2);
+}
+
+static uint64_t sc_irqoff_stats(SC_ARGS)
+{
+    return (uint64_t)(int64_t)irqoff_stats((int)a0, (irqoff_stat_t *)a1, (int)a2);
+}
+
+static uint64_t sc_irqlat_stats(SC_ARGS)
+{
+    return (uint64_t)(int64_t)irqtrace_stats((int)a0, (irqlat_stats_t *)a1);
+}
+
+typedef uint64_t (*syscall_fn_t)(uint64_t, uint64_t, uint64_t, uint64_t, uint64_t, uint64_t);
+
+typedef struct syscall_entry {
+    syscall_fn_t fn;
+    uint8_t arity;
+    uint8_t flags;
+    const char *name;
+} syscall_entry_t;
+
+#define SC(n, ar, fl) { sc_##n, ar, fl, #n }
+
+// Indexada por número de syscall (rax)
+static const syscall_entry_t syscall_table[SYS_CALLS_QTY] = {
+    [0] = SC(read_tty, 2, SYSCALL_F_LEGACY | SYSCALL_F_BLOCKS),
+    [1] = SC(write_tty, 2, SYSCALL_F_LEGACY),
+    [2] = SC(clear, 0, 0),
+    [3] = SC(hours, 0, 0),
+    [4] = SC(minutes, 0, 0),
+    [5] = SC(seconds, 0, 0),
+    [6] = SC(scr_height, 0, 0),
+    [7] = SC(scr_width, 0, 0),
+    [8] = SC(draw_rect, 5, 0),
+    [9] = SC(sleep, 1, SYSCALL_F_BLOCKS),
+    [10] = SC(reg_info, 1, 0),
+    [11] = SC(printmem, 1, 0),
+    [12] = SC(pixel_plus, 0, 0),
+    [13] = SC(pixel_minus, 0, 0),
+    [14] = SC(beep, 2, SYSCALL_F_BLOCKS),
+    [15] = SC(stop_speaker, 0, 0),
+    [16] = SC(draw_cursor, 0, 0),
+    [17] = SC(write_color, 3, SYSCALL_F_LEGACY),
+    [18] = SC(malloc, 1, 0),
+    [19] = SC(free, 1, 0),
+    [20] = SC(mem_info, 1, 0),
+    [21] = SC(getpid, 0, 0),
+    [22] = SC(create_proc, 5, 0),
+    [23] = SC(kill, 1, 0),
+    [24] = SC(block, 1, SYSCALL_F_BLOCKS),
+    [25] = SC(unblock, 1, 0),
+    [26] = SC(nice, 2, 0),
+    [27] = SC(yield, 0, SYSCALL_F_BLOCKS),
+    [28] = SC(wait_pid, 2, SYSCALL_F_BLOCKS),
+    [29] = SC(exit, 1, SYSCALL_F_NORETURN),
+    [30] = SC(proc_snapshot, 2, 0),
+    [31] = SC(sem_open, 2, 0),
+    [32] = SC(sem_wait, 1, SYSCALL_F_BLOCKS),
+    [33] = SC(sem_post, 1, 0),
+    [34] = SC(sem_close, 1, 0),
+    [35] = SC(sem_unlink, 1, 0),
+    [36] = SC(pipe_open, 2, 0),
+    [37] = SC(pipe_close, 1, 0),
+    [38] = SC(pipe_read, 3, SYSCALL_F_BLOCKS),
+    [39] = SC(pipe_write, 3, SYSCALL_F_BLOCKS),
+    [40] = SC(pipe_unlink, 1, 0),
+    [41] = SC(read, 3, SYSCALL_F_BLOCKS),
+    [42] = SC(write, 3, SYSCALL_F_BLOCKS),
+    [43] = SC(close, 1, 0),
+    [44] = SC(dup2, 2, 0),
+    [45] = SC(create_proc_ex, 6, 0),
+    [46] = SC(mm_stats, 1, 0),
+    [47] = SC(wait_children, 1, SYSCALL_F_BLOCKS),
+    [48] = SC(poll, 3, SYSCALL_F_BLOCKS),
+    [49] = SC(fcntl, 3, 0),
+    [50] = SC(futex_wait, 2, SYSCALL_F_BLOCKS),
+    [51] = SC(futex_wake, 2, 0),
+    [52] = SC(video_batch, 1, 0),
+    [53] = SC(tls_get, 0, 0),
+    [54] = SC(tls_alloc, 2, 0),
+    [55] = SC(mem_bench, 3, 0),
+    [56] = SC(play_melody, 2, 0),
+    [57] = SC(dmesg, 3, 0),
+    [58] = SC(klog_level, 1, 0),
+    [59] = SC(serial_open, 1, 0),
+    [60] = SC(ioctl, 3, 0),
+    [61] = SC(syscall_stats, 3, 0),
+    [62] = SC(nop, 0, 0),
+    [63] = SC(kdata, 0, 0),
+    [64] = SC(io_ring_setup, 1, 0),
+    [65] = SC(io_ring_enter, 1, SYSCALL_F_BLOCKS),
+    [66] = SC(readv, 3, SYSCALL_F_BLOCKS),
+    [67] = SC(writev, 3, SYSCALL_F_BLOCKS),
+    [68] = SC(irqoff_stats, 3, 0),
+    [69] = SC(irqlat_stats, 2, 0),
+};
+
+// READ copia hasta max entradas (una por syscall definida) y retorna cuántas;
+// RESET pone los contadores en cero
+static uint64_t sys_syscall_stats(int op, syscall_stat_t *out, int max)
+{
+    if (op == SYSCALL_STATS_RESET)
+    {
+        memset(syscall_counters, 0, sizeof(syscall_counters));
+        return 0;
+    }
+    if (op != SYSCALL_STATS_READ || out == NULL || max <= 0)
+    {
+        return (uint64_t)-1;
+    }
+
+    int n = 0;
+    for (int i = 0; i < SYS_CALLS_QTY && n < max; i++)
+    {
+        const syscall_entry_t *entry = &syscall_table[i];
+        if (entry->fn == NULL)
+        {
+            continue;
+        }
+
+        syscall_stat_t *st = &out[n++];
+        st->number = i;
+        st->arity = entry->arity;
+        st->flags = entry->flags;
+        int j = 0;
+        for (; j < SYSCALL_NAME_MAX - 1 && entry->name[j]; j++)
+        {
+            st->name[j] = entry->name[j];
+        }
+        st->name[j] = 0;
+        st->count = syscall_counters[i].count;
+        st->cycles = syscall_counters[i].cycles;
+        st->max_cycles = syscall_counters[i].max_cycles;
+        memcpy(st->hist, syscall_counters[i].hist, sizeof(st->hist));
+    }
+    return n;
+}
+
+uint64_t syscall_dispatcher(uint64_t rdi, uint64_t rsi, uint64_t rdx, uint64_t r10, uint64_t r8, uint64_t r9, uint64_t rax)
+{
+    if (rax >= SYS_CALLS_QTY || syscall_table[rax].fn == NULL)
     {
-    case 0:
-        return sys_read_tty(rdi, (char *)rsi);
-    case 1:
-        return sys_write_tty(rdi, (char)rsi);
-    case 2:
-        return sys_clear();
-    case 3:
-        return sys_getHours();
-    case 4:
-        return sys_getMinutes();
-    case 5:
-        return sys_getSeconds();
-    case 6:
-        return sys_getScrHeight();
-    case 7:
-        return sys_getScrWidth();
-    case 8:
-        r = (r8 >> 16) & 0xFF;
-        g = (r8 >> 8) & 0xFF;
-        b = r8 & 0xFF;
-        color.r = r;
-        color.g = g;
-        color.b = b;
-        sys_drawRectangle(rdi, rsi, rdx, r10, color);
-        return 1;
-    case 9:
-        sys_sleep(rdi);
-        return 1;
-    case 10:
-        return sys_registerInfo((uint64_t *)rdi);
-    case 11:
-        return sys_printmem((uint64_t *)rdi);
-    case 12:
-        return sys_pixelPlus();
-    case 13:
-        return sys_pixelMinus();
-    case 14:
-        return sys_playSpeaker((uint32_t)rdi, rsi);
-    case 15:
-        return sys_stopSpeaker();
-    case 16:
-        return sys_drawCursor();
-    case 17:
-        r = (rdx >> 16) & 0xFF;
-        g = (rdx >> 8) & 0xFF;
-        b = rdx & 0xFF;
-        color.r = r;
-        color.g = g;
-        color.b = b;
-        return sys_writeColor(rdi, (char)rsi, color);
-    case 18:
-        return sys_malloc((size_t)rdi);
-    case 19:
-        return sys_free((void*)rdi);
-    case 20:
-        return sys_mem_info((memory_info_t*)rdi);
-    case 21:
-        return sys_getpid();
-    case 22:
-        return sys_create_process((void (*)(int, char**))rdi, (int)rsi, (char**)rdx, (const char*)r10, (uint8_t)r8);
-    case 23:
-        return sys_kill((int)rdi);
-    case 24:
-        return sys_block((int)rdi);
-    case 25:
-        return sys_unblock((int)rdi);
-    case 26:
-        return sys_nice((int)rdi, (uint8_t)rsi);
-    case 27:
-        return sys_yield();
-    case 28:
-        return sys_wait_pid((int)rdi, (int *)rsi);
-    case 29:
-        return sys_exit((int)rdi);
-    case 30:
-        return sys_proc_snapshot((proc_info_t*)rdi, rsi);
-    case 31:
-        return sys_sem_open((const char*)rdi, (unsigned int)rsi);
-    case 32:
-        return sys_sem_wait((int)rdi);
-    case 33:
-        return sys_sem_post((int)rdi);
-    case 34:
-        return sys_sem_close((int)rdi);
-    case 35:
-        return sys_sem_unlink((const char*)rdi);
-    case 36:
-        return sys_pipe_open((const char*)rdi, (int)rsi);
-    case 37:
-        return sys_pipe_close((int)rdi);
-    case 38:
-        return sys_pipe_read((int)rdi, (void*)rsi, (int)rdx);
-    case 39:
-        return sys_pipe_write((int)rdi, (const void*)rsi, (int)rdx);
-    case 40:
-        return sys_pipe_unlink((const char*)rdi);
-    case 41:
-        return sys_read((int)rdi, (void*)rsi, (int)rdx);
-    case 42:
-        return sys_write((int)rdi, (const void*)rsi, (int)rdx);
-    case 43:
-        return sys_close((int)rdi);
-    case 44:
-        return sys_dup2((int)rdi, (int)rsi);
-    case 45:
-        return sys_create_process_ex((void (*)(int, char**))rdi, (int)rsi, (char**)rdx, (const char*)r10, (uint8_t)r8, (int)r9);
-    case 46:
-        return sys_mm_get_stats((mm_stats_t*)rdi);
-    case 47:
-        return sys_wait_children((int *)rdi);
-    default:
         return 0;
     }
+
+    const syscall_entry_t *entry = &syscall_table[rax];
+    syscall_counter_t *counter = &syscall_counters[rax];
+    counter->count++;
+
+    irqoff_site_t *site = &syscall_sites[rax];
+    if (site->name == NULL)
+    {
+        site->name = entry->name;
+        site->kind = IRQOFF_SYSCALL;
+    }
+    irqoff_begin(site);
+
+    uint64_t start = rdtsc();
+    uint64_t ret = entry->fn(rdi, rsi, rdx, r10, r8, r9);
+    syscall_account(counter, rdtsc() - start);
+    irqoff_end();
+    return ret;
 }
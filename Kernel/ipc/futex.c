@@ -0,0 +1,95 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include "futex.h"
+#include "sched.h"
+#include "spinlock.h"
+#include "wait_queue.h"
+#include "errno.h"
+
+// Tabla hash de colas de espera; cada proceso guarda en futex_addr la
+// dirección por la que espera para que wake distinga colisiones del bucket
+
+typedef struct futex_bucket {
+    spinlock_t lock;
+    wait_queue_t waiters;
+} futex_bucket_t;
+
+static futex_bucket_t buckets[FUTEX_HASH_BUCKETS];
+static bool futex_initialized = false;
+
+static futex_bucket_t *futex_bucket(volatile uint32_t *addr);
+
+static futex_bucket_t *futex_bucket(volatile uint32_t *addr) {
+    if (!futex_initialized) {
+        for (int i = 0; i < FUTEX_HASH_BUCKETS; i++) {
+            spinlock_init(&buckets[i].lock);
+            wait_queue_init(&buckets[i].waiters, &buckets[i].lock);
+        }
+        futex_initialized = true;
+    }
+
+    uint64_t key = (uint64_t)(uintptr_t)addr >> 2;
+    key *= 0x9E3779B97F4A7C15ULL;  // hash multiplicativo de Fibonacci
+    return &buckets[key >> 59];    // 5 bits = 32 buckets
+}
+
+// Bloquea si *addr sigue valiendo expected; el chequeo se hace con el lock
+// del bucket tomado para no perder un wake entre la lectura y el bloqueo
+int futex_wait(volatile uint32_t *addr, uint32_t expected) {
+    if (addr == NULL || ((uintptr_t)addr & 3) != 0) {
+        return E_INVAL;
+    }
+
+    pcb_t *current = sched_current();
+    if (current == NULL) {
+        return -1;
+    }
+
+    futex_bucket_t *b = futex_bucket(addr);
+    uint64_t flags = spinlock_lock_irqsave(&b->lock);
+
+    if (__atomic_load_n(addr, __ATOMIC_SEQ_CST) != expected) {
+        spinlock_unlock_irqrestore(&b->lock, flags);
+        return E_AGAIN;
+    }
+
+    current->futex_addr = (uintptr_t)addr;
+    wait_queue_add(&b->waiters, &current->wait_node, current);
+
+    current->state = BLOCKED;
+    current->ticks_left = 0;
+
+    spinlock_unlock_irqrestore(&b->lock, flags);
+
+    sched_force_yield();
+    return 0;
+}
+
+// Despierta hasta n procesos esperando en addr; retorna cuántos despertó
+int futex_wake(volatile uint32_t *addr, int n) {
+    if (addr == NULL || ((uintptr_t)addr & 3) != 0 || n <= 0) {
+        return E_INVAL;
+    }
+
+    futex_bucket_t *b = futex_bucket(addr);
+    int woken = 0;
+
+    uint64_t flags = spinlock_lock_irqsave(&b->lock);
+
+    wait_node_t *node = b->waiters.head;
+    while (node != NULL && woken < n) {
+        wait_node_t *next = node->next;
+        pcb_t *proc = node->proc;
+        if (proc != NULL && proc->futex_addr == (uintptr_t)addr) {
+            wait_queue_remove(&b->waiters, node);
+            proc->futex_addr = 0;
+            if (proc_unblock(proc->pid) == 0) {
+                woken++;
+            }
+        }
+        node = next;
+    }
+
+    spinlock_unlock_irqrestore(&b->lock, flags);
+    return woken;
+}
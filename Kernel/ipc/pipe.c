@@ -4,6 +4,7 @@
 #include "interrupts.h"
 #include "lib.h"
 #include "sched.h"
+#include "errno.h"
 
 // Implementación de pipes nominales con bloqueo y wakeups explícitos
 
@@ -16,10 +17,13 @@ static void pipe_name_copy(char *dst, const char *src);
 static uint64_t irq_save(void);                      // Helpers críticos
 static void irq_restore(uint64_t flags);
 static void pipe_free(kpipe_t *p);
-static void enqueue_reader(kpipe_t *p, pcb_t *proc, pipe_waiter_t *w); // Manejo de waiters
-static void enqueue_writer(kpipe_t *p, pcb_t *proc, pipe_waiter_t *w);
-static pcb_t* dequeue_reader(kpipe_t *p);
-static pcb_t* dequeue_writer(kpipe_t *p);
+static void ring_copy_in(kpipe_t *p, uint32_t pos, const uint8_t *src, uint32_t len);  // Copias al ring
+static void ring_copy_out(kpipe_t *p, uint32_t pos, uint8_t *dst, uint32_t len);
+static void wake_reader(kpipe_t *p);                 // Fronteras vacío/lleno
+static void wake_writer(kpipe_t *p);
+static int block_reader(kpipe_t *p, uint32_t head);
+static int block_writer(kpipe_t *p, uint32_t tail);
+static uint64_t iov_total(const iovec_t *iov, int cnt);
 
 static uint32_t pipe_hash(const char *name) {
     uint32_t hash = 5381;
@@ -64,82 +68,124 @@ static void irq_restore(uint64_t flags) {
     }
 }
 
+// Las colas de espera usan nodos embebidos en los PCB: no hay nada que liberar
 static void pipe_free(kpipe_t *p) {
     if (p == NULL) return;
-    
-    // Liberar waiters de lectura
-    pipe_waiter_t *w = p->r_head;
-    while (w != NULL) {
-        pipe_waiter_t *next = w->next;
-        mm_free(w);
-        w = next;
+    mm_free(p);
+}
+
+static void ring_copy_in(kpipe_t *p, uint32_t pos, const uint8_t *src, uint32_t len) {
+    uint32_t idx = pos & PIPE_MASK;
+    uint32_t first = PIPE_CAP - idx;
+    if (first > len) first = len;
+    memcpy(&p->buf[idx], src, first);
+    if (len > first) {
+        memcpy(&p->buf[0], src + first, len - first);
     }
-    
-    // Liberar waiters de escritura
-    w = p->w_head;
-    while (w != NULL) {
-        pipe_waiter_t *next = w->next;
-        mm_free(w);
-        w = next;
+}
+
+static void ring_copy_out(kpipe_t *p, uint32_t pos, uint8_t *dst, uint32_t len) {
+    uint32_t idx = pos & PIPE_MASK;
+    uint32_t first = PIPE_CAP - idx;
+    if (first > len) first = len;
+    memcpy(dst, &p->buf[idx], first);
+    if (len > first) {
+        memcpy(dst + first, &p->buf[0], len - first);
     }
-    
-    mm_free(p);
 }
 
-static void enqueue_reader(kpipe_t *p, pcb_t *proc, pipe_waiter_t *w) {
-    if (w == NULL) return;
-    
-    w->proc = proc;
-    w->next = NULL;
-    
-    if (p->r_tail == NULL) {
-        p->r_head = p->r_tail = w;
-    } else {
-        p->r_tail->next = w;
-        p->r_tail = w;
+// Despierta un lector tras publicar datos. La barrera completa ordena el
+// store de tail contra la lectura de la cola (pareja de la de block_reader):
+// o el lector ve el nuevo tail o nosotros vemos su waiter encolado.
+static void wake_reader(kpipe_t *p) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (wait_queue_empty(&p->readers_q) && wait_queue_empty(&p->pollers)) {
+        return;
+    }
+    uint64_t flags = spinlock_lock_irqsave(&p->lock);
+    pcb_t *proc = wait_queue_pop(&p->readers_q);
+    wait_queue_wake_all(&p->pollers);
+    spinlock_unlock_irqrestore(&p->lock, flags);
+    if (proc != NULL) {
+        proc_unblock(proc->pid);
     }
 }
 
-static void enqueue_writer(kpipe_t *p, pcb_t *proc, pipe_waiter_t *w) {
-    if (w == NULL) return;
-    
-    w->proc = proc;
-    w->next = NULL;
-    
-    if (p->w_tail == NULL) {
-        p->w_head = p->w_tail = w;
-    } else {
-        p->w_tail->next = w;
-        p->w_tail = w;
+static void wake_writer(kpipe_t *p) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (wait_queue_empty(&p->writers_q) && wait_queue_empty(&p->pollers)) {
+        return;
+    }
+    uint64_t flags = spinlock_lock_irqsave(&p->lock);
+    pcb_t *proc = wait_queue_pop(&p->writers_q);
+    wait_queue_wake_all(&p->pollers);
+    spinlock_unlock_irqrestore(&p->lock, flags);
+    if (proc != NULL) {
+        proc_unblock(proc->pid);
     }
 }
 
-static pcb_t* dequeue_reader(kpipe_t *p) {
-    if (p->r_head == NULL) return NULL;
-    
-    pipe_waiter_t *w = p->r_head;
-    p->r_head = w->next;
-    if (p->r_head == NULL) {
-        p->r_tail = NULL;
+// Bloquea al lector en la frontera "vacío". Se encola primero y se re-verifica
+// después, así un escritor concurrente no puede perder el wakeup.
+// Retorna 0 para reintentar la lectura o -1 ante error.
+static int block_reader(kpipe_t *p, uint32_t head) {
+    pcb_t *current = sched_current();
+    if (current == NULL) {
+        return -1;
     }
-    
-    pcb_t *proc = w->proc;
-    mm_free(w);
-    return proc;
+
+    // Nodo embebido en el PCB: bloquear no asigna memoria
+    uint64_t flags = spinlock_lock_irqsave(&p->lock);
+    wait_queue_add(&p->readers_q, &current->wait_node, current);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&p->tail, __ATOMIC_ACQUIRE) != head || p->writers == 0) {
+        // Llegaron datos o se cerró el último escritor mientras encolábamos
+        wait_queue_remove(&p->readers_q, &current->wait_node);
+        spinlock_unlock_irqrestore(&p->lock, flags);
+        return 0;
+    }
+
+    // Marcar BLOQUEADO dentro de la sección crítica (previene lost wakeup)
+    current->state = BLOCKED;
+    current->ticks_left = 0;
+    spinlock_unlock_irqrestore(&p->lock, flags);
+
+    sched_force_yield();
+    return 0;
 }
 
-static pcb_t* dequeue_writer(kpipe_t *p) {
-    if (p->w_head == NULL) return NULL;
-    
-    pipe_waiter_t *w = p->w_head;
-    p->w_head = w->next;
-    if (p->w_head == NULL) {
-        p->w_tail = NULL;
+static int block_writer(kpipe_t *p, uint32_t tail) {
+    pcb_t *current = sched_current();
+    if (current == NULL) {
+        return -1;
     }
-    
-    pcb_t *proc = w->proc;
-    mm_free(w);
-    return proc;
+
+    // Nodo embebido en el PCB: bloquear no asigna memoria
+    uint64_t flags = spinlock_lock_irqsave(&p->lock);
+    wait_queue_add(&p->writers_q, &current->wait_node, current);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (tail - __atomic_load_n(&p->head, __ATOMIC_ACQUIRE) < PIPE_CAP || p->readers == 0) {
+        wait_queue_remove(&p->writers_q, &current->wait_node);
+        spinlock_unlock_irqrestore(&p->lock, flags);
+        return 0;
+    }
+
+    current->state = BLOCKED;
+    current->ticks_left = 0;
+    spinlock_unlock_irqrestore(&p->lock, flags);
+
+    sched_force_yield();
+    return 0;
+}
+
+static uint64_t iov_total(const iovec_t *iov, int cnt) {
+    uint64_t total = 0;
+    for (int i = 0; i < cnt; i++) {
+        total += iov[i].iov_len;
+    }
+    return total;
 }
 
 // Obtiene (o crea) un pipe identificado por nombre y ajusta contadores de uso
@@ -174,15 +220,18 @@ int kpipe_open(const char* name, bool for_read, bool for_write, kpipe_t **out) {
     }
     
     memset(new_pipe, 0, sizeof(kpipe_t));
+    spinlock_init(&new_pipe->lock);
+    spinlock_init(&new_pipe->rd_lock);
+    spinlock_init(&new_pipe->wr_lock);
     pipe_name_copy(new_pipe->name, name);
-    new_pipe->r = 0;
-    new_pipe->w = 0;
-    new_pipe->size = 0;
+    new_pipe->head = 0;
+    new_pipe->tail = 0;
     new_pipe->readers = for_read ? 1 : 0;
     new_pipe->writers = for_write ? 1 : 0;
     new_pipe->unlinked = false;
-    new_pipe->r_head = new_pipe->r_tail = NULL;
-    new_pipe->w_head = new_pipe->w_tail = NULL;
+    wait_queue_init(&new_pipe->readers_q, &new_pipe->lock);
+    wait_queue_init(&new_pipe->writers_q, &new_pipe->lock);
+    wait_queue_init(&new_pipe->pollers, &new_pipe->lock);
     new_pipe->next_hash = NULL;
     
     // Insertar en hash table
@@ -216,7 +265,7 @@ int kpipe_close(kpipe_t *p, bool was_read, bool was_write) {
         return -1;
     }
     
-    uint64_t flags = irq_save();
+    uint64_t flags = spinlock_lock_irqsave(&p->lock);
     
     if (was_read && p->readers > 0) {
         p->readers--;
@@ -225,38 +274,23 @@ int kpipe_close(kpipe_t *p, bool was_read, bool was_write) {
         p->writers--;
     }
     
-    // Si ya no hay writers, despertar todos los lectores (EOF)
-    bool should_wake_readers = (p->writers == 0 && p->r_head != NULL);
-    
-    // Si ya no hay readers, despertar todos los escritores (EPIPE)
-    bool should_wake_writers = (p->readers == 0 && p->w_head != NULL);
-    
-    bool should_free = (p->unlinked && p->readers == 0 && p->writers == 0);
-    
-    irq_restore(flags);
-    
-    // Despertar fuera de la sección crítica
-    if (should_wake_readers) {
-        flags = irq_save();
-        pcb_t *proc;
-        while ((proc = dequeue_reader(p)) != NULL) {
-            irq_restore(flags);
-            proc_unblock(proc->pid);
-            flags = irq_save();
-        }
-        irq_restore(flags);
+    // Sin writers: despertar a todos los lectores (EOF).
+    // Sin readers: despertar a todos los escritores (EPIPE).
+    if (p->writers == 0) {
+        wait_queue_wake_all(&p->readers_q);
     }
-    
-    if (should_wake_writers) {
-        flags = irq_save();
-        pcb_t *proc;
-        while ((proc = dequeue_writer(p)) != NULL) {
-            irq_restore(flags);
-            proc_unblock(proc->pid);
-            flags = irq_save();
-        }
-        irq_restore(flags);
+    if (p->readers == 0) {
+        wait_queue_wake_all(&p->writers_q);
     }
+
+    // EOF/EPIPE cambian la disponibilidad para quienes hacen poll
+    if (p->writers == 0 || p->readers == 0) {
+        wait_queue_wake_all(&p->pollers);
+    }
+
+    bool should_free = (p->unlinked && p->readers == 0 && p->writers == 0);
+    
+    spinlock_unlock_irqrestore(&p->lock, flags);
     
     if (should_free) {
         pipe_free(p);
@@ -265,204 +299,155 @@ int kpipe_close(kpipe_t *p, bool was_read, bool was_write) {
     return 0;
 }
 
-// Lee del buffer circular; bloquea si no hay datos y aún existen escritores
-int kpipe_read(kpipe_t *p, void *buf, int n) {
-    if (p == NULL || buf == NULL || n <= 0) {
+// Lee del buffer circular; bloquea si no hay datos y aún existen escritores.
+// Camino rápido sin deshabilitar interrupciones: solo el consumidor mueve head.
+int kpipe_read(kpipe_t *p, void *buf, int n, bool nonblock) {
+    if (buf == NULL || n <= 0) {
         return -1;
     }
-    
-    uint8_t *dest = (uint8_t *)buf;
-    int total_read = 0;
-    
-    while (total_read < n) {
-        uint64_t flags = irq_save();
-
-        // Camino rápido: hay datos disponibles
-        if (p->size > 0) {
-            int remaining = n - total_read;
-            int to_read = ((int)p->size < remaining) ? (int)p->size : remaining;
-            
-            // Copiar desde el ring buffer
-            for (int i = 0; i < to_read; i++) {
-                dest[total_read++] = p->buf[p->r];
-                p->r = (p->r + 1) % PIPE_CAP;
-                p->size--;
-            }
-            
-            // Si hay escritores esperando, despertar uno
-            bool should_wake_writer = (p->w_head != NULL);
-            pcb_t *writer_proc = NULL;
-            if (should_wake_writer) {
-                writer_proc = dequeue_writer(p);
-            }
-            
-            irq_restore(flags);
-            
-            // Despertar fuera de la SC
-            if (writer_proc != NULL) {
-                proc_unblock(writer_proc->pid);
-            }
-            
-            // Si leímos algo, devolver lo leído (transferencia parcial permitida)
-            if (total_read > 0) {
-                return total_read;
-            }
-            continue;
-        }
-        
-        // size == 0: verificar si hay writers o es EOF
-        if (p->writers == 0) {
-            // EOF: no hay más escritores
-            irq_restore(flags);
-            return total_read; // 0 si no leímos nada, >0 si leímos algo antes
-        }
-        
-        // size == 0 && writers > 0: bloquear
-        pcb_t *current = sched_current();
-        if (current == NULL) {
-            irq_restore(flags);
-            return -1;
-        }
-        
-        // Pre-asignar waiter ANTES de necesitarlo (aún en sección crítica pero antes de encolar)
-        // Necesitamos salir temporalmente de la sección crítica para asignar memoria
-        irq_restore(flags);
+    iovec_t iov = {buf, (uint64_t)n};
+    return kpipe_readv(p, &iov, 1, nonblock);
+}
 
-        pipe_waiter_t *waiter = (pipe_waiter_t *)mm_malloc(sizeof(pipe_waiter_t));
-        if (waiter == NULL) {
-            return -1;  // Falló la asignación de memoria
-        }
+// Reparte lo disponible entre los iovecs en orden, con un único avance de
+// head y un único wakeup para todo el vector
+int kpipe_readv(kpipe_t *p, const iovec_t *iov, int cnt, bool nonblock) {
+    if (p == NULL || iov == NULL || cnt <= 0 || iov_total(iov, cnt) == 0) {
+        return -1;
+    }
 
-        // Re-ingresar a la sección crítica
-        flags = irq_save();
+    spinlock_lock(&p->rd_lock);
+    while (1) {
+        uint32_t head = p->head;
+        uint32_t avail = __atomic_load_n(&p->tail, __ATOMIC_ACQUIRE) - head;
+
+        if (avail > 0) {
+            uint32_t done = 0;
+            for (int i = 0; i < cnt && done < avail; i++) {
+                uint32_t len = avail - done;
+                if (iov[i].iov_len < len) {
+                    len = (uint32_t)iov[i].iov_len;
+                }
+                ring_copy_out(p, head + done, (uint8_t *)iov[i].iov_base, len);
+                done += len;
+            }
+            __atomic_store_n(&p->head, head + done, __ATOMIC_RELEASE);
+            spinlock_unlock(&p->rd_lock);
 
-        // Verificación doble de condiciones al re-ingresar (pudieron haber cambiado)
-        if (p->size > 0) {
-            // Los datos se volvieron disponibles mientras asignábamos memoria
-            irq_restore(flags);
-            mm_free(waiter);
-            continue;  // Reintentar lectura
+            // Frontera "lleno": puede haber escritores esperando espacio
+            wake_writer(p);
+            return (int)done;
         }
 
-        if (p->writers == 0) {
-            // Los escritores se cerraron mientras asignábamos memoria
-            irq_restore(flags);
-            mm_free(waiter);
-            return total_read;
+        // Vacío: EOF si no quedan escritores (re-chequeando datos publicados antes del close)
+        if (__atomic_load_n(&p->writers, __ATOMIC_ACQUIRE) == 0) {
+            if (__atomic_load_n(&p->tail, __ATOMIC_ACQUIRE) != head) {
+                continue;
+            }
+            spinlock_unlock(&p->rd_lock);
+            return 0;
         }
 
-        enqueue_reader(p, current, waiter);
+        // Vacío con escritores: bloquear sin retener el extremo de lectura
+        spinlock_unlock(&p->rd_lock);
+        if (nonblock) {
+            return E_AGAIN;
+        }
+        if (block_reader(p, head) < 0) {
+            return -1;
+        }
+        spinlock_lock(&p->rd_lock);
+    }
+}
 
-        // *** ARREGLO: Marcar como BLOQUEADO dentro de la sección crítica
-        // (previene lost wakeup, igual que en semáforos)
-        current->state = BLOCKED;
-        current->ticks_left = 0;
-        
-        irq_restore(flags);
-        
-        // Ceder CPU sin busy-wait
-        sched_force_yield();
-        
-        // Al despertar, reintentar el loop
+// Escribe en el pipe; bloquea si el buffer está lleno y hay lectores activos.
+// Camino rápido sin deshabilitar interrupciones: solo el productor mueve tail.
+int kpipe_write(kpipe_t *p, const void *buf, int n, bool nonblock) {
+    if (buf == NULL || n <= 0) {
+        return -1;
     }
-    
-    return total_read;
+    iovec_t iov = {(void *)buf, (uint64_t)n};
+    return kpipe_writev(p, &iov, 1, nonblock);
 }
 
-// Escribe en el pipe; bloquea si el buffer está lleno y hay lectores activos
-int kpipe_write(kpipe_t *p, const void *buf, int n) {
-    if (p == NULL || buf == NULL || n <= 0) {
+// Copia los iovecs en orden mientras haya espacio y publica tail una sola
+// vez: un lector nunca ve un registro a medias de un mismo writev
+int kpipe_writev(kpipe_t *p, const iovec_t *iov, int cnt, bool nonblock) {
+    if (p == NULL || iov == NULL || cnt <= 0 || iov_total(iov, cnt) == 0) {
         return -1;
     }
-    
-    const uint8_t *src = (const uint8_t *)buf;
-    int total_written = 0;
-    
-    while (total_written < n) {
-        uint64_t flags = irq_save();
-        
+
+    spinlock_lock(&p->wr_lock);
+    while (1) {
         // Verificar si hay lectores (EPIPE)
-        if (p->readers == 0) {
-            irq_restore(flags);
-            return -1; // EPIPE: no hay lectores
+        if (__atomic_load_n(&p->readers, __ATOMIC_ACQUIRE) == 0) {
+            spinlock_unlock(&p->wr_lock);
+            return -1;
         }
 
-        // Camino rápido: hay espacio disponible
-        if (p->size < PIPE_CAP) {
-            int space = (int)(PIPE_CAP - p->size);
-            int remaining = n - total_written;
-            int to_write = (space < remaining) ? space : remaining;
-            
-            // Copiar al ring buffer
-            for (int i = 0; i < to_write; i++) {
-                p->buf[p->w] = src[total_written++];
-                p->w = (p->w + 1) % PIPE_CAP;
-                p->size++;
+        uint32_t tail = p->tail;
+        uint32_t space = PIPE_CAP - (tail - __atomic_load_n(&p->head, __ATOMIC_ACQUIRE));
+
+        if (space > 0) {
+            uint32_t done = 0;
+            for (int i = 0; i < cnt && done < space; i++) {
+                uint32_t len = space - done;
+                if (iov[i].iov_len < len) {
+                    len = (uint32_t)iov[i].iov_len;
+                }
+                ring_copy_in(p, tail + done, (const uint8_t *)iov[i].iov_base, len);
+                done += len;
             }
-            
-            // Si hay lectores esperando, despertar uno
-            bool should_wake_reader = (p->r_head != NULL);
-            pcb_t *reader_proc = NULL;
-            if (should_wake_reader) {
-                reader_proc = dequeue_reader(p);
-            }
-            
-            irq_restore(flags);
-            
-            // Despertar fuera de la SC
-            if (reader_proc != NULL) {
-                proc_unblock(reader_proc->pid);
-            }
-            
-            // Si escribimos algo, devolver lo escrito (transferencia parcial permitida)
-            if (total_written > 0) {
-                return total_written;
-            }
-            continue;
-        }
-        
-        // size == PIPE_CAP: pipe lleno, bloquear
-        pcb_t *current = sched_current();
-        if (current == NULL) {
-            irq_restore(flags);
-            return -1;
-        }
-        
-        // Pre-asignar waiter ANTES de necesitarlo
-        // Salir temporalmente de la sección crítica para asignar memoria
-        irq_restore(flags);
+            __atomic_store_n(&p->tail, tail + done, __ATOMIC_RELEASE);
+            spinlock_unlock(&p->wr_lock);
 
-        pipe_waiter_t *waiter = (pipe_waiter_t *)mm_malloc(sizeof(pipe_waiter_t));
-        if (waiter == NULL) {
-            return -1;  // Falló la asignación de memoria
+            // Frontera "vacío": puede haber lectores esperando datos
+            wake_reader(p);
+            return (int)done;
         }
 
-        // Re-ingresar a la sección crítica
-        flags = irq_save();
-
-        // Verificación doble de condiciones al re-ingresar
-        if (p->size < PIPE_CAP) {
-            // El espacio se volvió disponible mientras asignábamos memoria
-            irq_restore(flags);
-            mm_free(waiter);
-            continue;  // Reintentar escritura
+        // Lleno: bloquear sin retener el extremo de escritura
+        spinlock_unlock(&p->wr_lock);
+        if (nonblock) {
+            return E_AGAIN;
+        }
+        if (block_writer(p, tail) < 0) {
+            return -1;
         }
+        spinlock_lock(&p->wr_lock);
+    }
+}
 
-        enqueue_writer(p, current, waiter);
+// Máscara POLL* para los extremos abiertos; si w != NULL registra al proceso.
+// El registro y la lectura de índices se hacen bajo el lock, así cualquier
+// escritura posterior pasa por wake_reader/wake_writer y ve el waiter.
+int kpipe_poll(kpipe_t *p, bool rd, bool wr, wait_node_t *w) {
+    if (p == NULL) {
+        return POLLNVAL;
+    }
 
-        // *** ARREGLO: Marcar como BLOQUEADO dentro de la sección crítica
-        current->state = BLOCKED;
-        current->ticks_left = 0;
-        
-        irq_restore(flags);
-        
-        // Ceder CPU sin busy-wait
-        sched_force_yield();
-        
-        // Al despertar, reintentar el loop
+    uint64_t flags = spinlock_lock_irqsave(&p->lock);
+    if (w != NULL) {
+        wait_queue_add(&p->pollers, w, sched_current());
     }
-    
-    return total_written;
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    uint32_t used = __atomic_load_n(&p->tail, __ATOMIC_ACQUIRE) -
+                    __atomic_load_n(&p->head, __ATOMIC_ACQUIRE);
+    int mask = 0;
+    if (rd) {
+        if (used > 0) mask |= POLLIN;
+        if (p->writers == 0) mask |= POLLHUP;
+    }
+    if (wr) {
+        if (p->readers == 0) {
+            mask |= POLLERR;
+        } else if (used < PIPE_CAP) {
+            mask |= POLLOUT;
+        }
+    }
+    spinlock_unlock_irqrestore(&p->lock, flags);
+    return mask;
 }
 
 // Desvincula el nombre del pipe; se libera cuando no quedan referencias
@@ -8,14 +8,28 @@ static int fd_pipe_read(file_t *file, void *buf, int n) {
     if (file == NULL || !file->can_read || file->ptr == NULL || buf == NULL || n <= 0) {
         return -1;
     }
-    return kpipe_read((kpipe_t *)file->ptr, buf, n);
+    return kpipe_read((kpipe_t *)file->ptr, buf, n, (file->flags & O_NONBLOCK) != 0);
 }
 
 static int fd_pipe_write(file_t *file, const void *buf, int n) {
     if (file == NULL || !file->can_write || file->ptr == NULL || buf == NULL || n <= 0) {
         return -1;
     }
-    return kpipe_write((kpipe_t *)file->ptr, buf, n);
+    return kpipe_write((kpipe_t *)file->ptr, buf, n, (file->flags & O_NONBLOCK) != 0);
+}
+
+static int fd_pipe_readv(file_t *file, const iovec_t *iov, int cnt) {
+    if (file == NULL || !file->can_read || file->ptr == NULL) {
+        return -1;
+    }
+    return kpipe_readv((kpipe_t *)file->ptr, iov, cnt, (file->flags & O_NONBLOCK) != 0);
+}
+
+static int fd_pipe_writev(file_t *file, const iovec_t *iov, int cnt) {
+    if (file == NULL || !file->can_write || file->ptr == NULL) {
+        return -1;
+    }
+    return kpipe_writev((kpipe_t *)file->ptr, iov, cnt, (file->flags & O_NONBLOCK) != 0);
 }
 
 static int fd_pipe_close(file_t *file) {
@@ -25,9 +39,19 @@ static int fd_pipe_close(file_t *file) {
     return kpipe_close((kpipe_t *)file->ptr, file->can_read, file->can_write);
 }
 
+static int fd_pipe_poll(file_t *file, struct wait_node *w) {
+    if (file == NULL || file->ptr == NULL) {
+        return POLLNVAL;
+    }
+    return kpipe_poll((kpipe_t *)file->ptr, file->can_read, file->can_write, w);
+}
+
 const struct fd_ops PIPE_OPS = {
     .read = fd_pipe_read,
     .write = fd_pipe_write,
-    .close = fd_pipe_close
+    .close = fd_pipe_close,
+    .poll = fd_pipe_poll,
+    .readv = fd_pipe_readv,
+    .writev = fd_pipe_writev
 };
 
@@ -0,0 +1,22 @@
+#include <stddef.h>
+#include "fd.h"
+#include "semaphore.h"
+
+// Adaptador para exponer los semáforos nombrados como file descriptors:
+// el handle es un fd de la tabla del proceso, así que buscarlo es O(1) y
+// se cierra solo en fd_table_destroy (exit o kill)
+
+static int fd_sem_close(file_t *file) {
+    if (file == NULL || file->ptr == NULL) {
+        return -1;
+    }
+    return ksem_close((ksem_t *)file->ptr);
+}
+
+// read/write no aplican: sys_read/sys_write retornan -1
+const struct fd_ops SEM_OPS = {
+    .read = NULL,
+    .write = NULL,
+    .close = fd_sem_close,
+    .poll = NULL
+};
@@ -24,13 +24,6 @@ static void sem_name_copy(char *dst, const char *src);
 static uint64_t irq_save(void);
 static void irq_restore(uint64_t flags);
 
-// Funciones auxiliares para la cola de procesos esperando
-static void wait_queue_init(wait_queue_t *q);
-static bool wait_queue_is_empty(const wait_queue_t *q);
-static void wait_queue_push(wait_queue_t *q, sem_waiter_t *node);
-static sem_waiter_t *wait_queue_pop(wait_queue_t *q);
-static sem_waiter_t *wait_queue_remove_proc(wait_queue_t *q, pcb_t *proc);
-
 // Funciones auxiliares para limpieza de semáforos
 static bool sem_ready_to_destroy_locked(ksem_t *sem);
 static void sem_free(ksem_t *sem);
@@ -93,91 +86,6 @@ static void irq_restore(uint64_t flags) {
     }
 }
 
-// Inicializa una cola de espera vacía
-static void wait_queue_init(wait_queue_t *q) {
-    if (q != NULL) {
-        q->head = NULL;
-        q->tail = NULL;
-    }
-}
-
-// Verifica si la cola de espera está vacía
-static bool wait_queue_is_empty(const wait_queue_t *q) {
-    return q == NULL || q->head == NULL;
-}
-
-// Agrega un proceso a la cola de espera
-static void wait_queue_push(wait_queue_t *q, sem_waiter_t *node) {
-    if (q == NULL || node == NULL) {
-        return;
-    }
-    node->next = NULL;
-    if (q->tail == NULL) {
-        q->head = node;
-        q->tail = node;
-    } else {
-        q->tail->next = node;
-        q->tail = node;
-    }
-}
-
-// Remueve y retorna el primer proceso de la cola de espera
-static sem_waiter_t *wait_queue_pop(wait_queue_t *q) {
-    if (q == NULL || q->head == NULL) {
-        return NULL;
-    }
-    sem_waiter_t *node = q->head;
-    q->head = node->next;
-    if (q->head == NULL) {
-        q->tail = NULL;
-    }
-    node->next = NULL;
-    return node;
-}
-
-// Remueve todas las instancias de un proceso específico de la cola
-static sem_waiter_t *wait_queue_remove_proc(wait_queue_t *q, pcb_t *proc) {
-    if (q == NULL || proc == NULL) {
-        return NULL;
-    }
-
-    sem_waiter_t *removed_head = NULL;
-    sem_waiter_t *removed_tail = NULL;
-
-    sem_waiter_t *prev = NULL;
-    sem_waiter_t *cursor = q->head;
-
-    while (cursor != NULL) {
-        sem_waiter_t *next = cursor->next;
-        if (cursor->proc == proc) {
-            if (prev == NULL) {
-                q->head = next;
-            } else {
-                prev->next = next;
-            }
-
-            if (q->tail == cursor) {
-                q->tail = prev;
-            }
-
-            cursor->next = NULL;
-            if (removed_tail == NULL) {
-                removed_head = cursor;
-                removed_tail = cursor;
-            } else {
-                removed_tail->next = cursor;
-                removed_tail = cursor;
-            }
-            cursor = next;
-            continue;
-        }
-        prev = cursor;
-        cursor = next;
-    }
-
-    return removed_head;
-}
-
 // Verifica si el semáforo está listo para ser destruido
 static bool sem_ready_to_destroy_locked(ksem_t *sem) {
     if (sem == NULL) {
@@ -186,22 +94,18 @@ static bool sem_ready_to_destroy_locked(ksem_t *sem) {
     if (sem->destroying) {
         return false;
     }
-    if (sem->unlinked && sem->refcount == 0 && wait_queue_is_empty(&sem->waiters)) {
+    if (sem->unlinked && sem->refcount == 0 && wait_queue_empty(&sem->waiters)) {
         sem->destroying = true;
         return true;
     }
     return false;
 }
 
-// Libera la memoria del semáforo y sus colas de espera
+// Libera la memoria del semáforo (la cola de espera ya está vacía)
 static void sem_free(ksem_t *sem) {
     if (sem == NULL) {
         return;
     }
-    sem_waiter_t *waiter;
-    while ((waiter = wait_queue_pop(&sem->waiters)) != NULL) {
-        mm_free(waiter);
-    }
     mm_free(sem);
 }
 
@@ -252,7 +156,7 @@ int ksem_open(const char *name, unsigned int init, ksem_t **out) {
 
     memset(new_sem, 0, sizeof(ksem_t));
     spinlock_init(&new_sem->lock);
-    wait_queue_init(&new_sem->waiters);
+    wait_queue_init(&new_sem->waiters, &new_sem->lock);
     sem_name_copy(new_sem->name, name);
     new_sem->count = init;
     new_sem->refcount = 1;
@@ -298,35 +202,35 @@ int ksem_wait(ksem_t *sem) {
         return -1;
     }
 
-    sem_waiter_t *waiter = (sem_waiter_t *)mm_malloc(sizeof(sem_waiter_t));
-    if (waiter == NULL) {
-        extern void ncPrintDec(uint64_t value);
-        extern void ncPrint(const char *string);
-        ncPrint("[KERNEL] sem_wait: mm_malloc FAILED for PID ");
-        ncPrintDec(current->pid);
-        ncPrint("\n");
-        return -1;
-    }
-
     uint64_t flags = spinlock_lock_irqsave(&sem->lock);
 
-    if (sem->count > 0) {
-        sem->count--;
-        spinlock_unlock_irqrestore(&sem->lock, flags);
-        mm_free(waiter);
-        return 0;
-    }
+    while (1) {
+        if (sem->count > 0) {
+            sem->count--;
+            spinlock_unlock_irqrestore(&sem->lock, flags);
+            return 0;
+        }
 
-    waiter->proc = current;
-    wait_queue_push(&sem->waiters, waiter);
+        // Nodo embebido en el PCB: bloquear no asigna memoria
+        current->sem_handoff = false;
+        wait_queue_add(&sem->waiters, &current->wait_node, current);
 
-    current->state = BLOCKED;
-    current->ticks_left = 0;
+        current->state = BLOCKED;
+        current->ticks_left = 0;
 
-    spinlock_unlock_irqrestore(&sem->lock, flags);
+        spinlock_unlock_irqrestore(&sem->lock, flags);
 
-    sched_force_yield();
-    return 0;
+        sched_force_yield();
+
+        flags = spinlock_lock_irqsave(&sem->lock);
+        if (current->sem_handoff) {
+            current->sem_handoff = false;
+            spinlock_unlock_irqrestore(&sem->lock, flags);
+            return 0;
+        }
+        // Despertado sin post (sys_unblock): proc_unblock ya lo sacó de la
+        // cola, así que se vuelve a mirar el contador
+    }
 }
 
 // Incrementa el semáforo (despierta un proceso esperando si hay alguno)
@@ -335,39 +239,26 @@ int ksem_post(ksem_t *sem) {
         return -1;
     }
 
-    sem_waiter_t *waiter = NULL;
-    pcb_t *target = NULL;
-
     uint64_t flags = spinlock_lock_irqsave(&sem->lock);
 
-    if (!wait_queue_is_empty(&sem->waiters)) {
-        waiter = wait_queue_pop(&sem->waiters);
-        if (waiter != NULL) {
-            target = waiter->proc;
-        }
-    } else {
-        if (sem->count < UINT32_MAX) {
-            sem->count++;
-        }
+    // La unidad pasa directo al proceso despertado, que no la busca en count
+    pcb_t *target = wait_queue_pop(&sem->waiters);
+    if (target != NULL) {
+        target->sem_handoff = true;
+    } else if (sem->count < UINT32_MAX) {
+        sem->count++;
     }
 
     spinlock_unlock_irqrestore(&sem->lock, flags);
 
-    if (waiter != NULL) {
-        bool wake_success = false;
-        if (target != NULL) {
-            wake_success = (proc_unblock(target->pid) == 0);
-        }
-
-        if (!wake_success) {
-            uint64_t fix_flags = spinlock_lock_irqsave(&sem->lock);
-            if (sem->count < UINT32_MAX) {
-                sem->count++;
-            }
-            spinlock_unlock_irqrestore(&sem->lock, fix_flags);
+    // Si el proceso ya no estaba bloqueado, el post no se pierde
+    if (target != NULL && proc_unblock(target->pid) != 0) {
+        uint64_t fix_flags = spinlock_lock_irqsave(&sem->lock);
+        target->sem_handoff = false;
+        if (sem->count < UINT32_MAX) {
+            sem->count++;
         }
-
-        mm_free(waiter);
+        spinlock_unlock_irqrestore(&sem->lock, fix_flags);
     }
 
     return 0;
@@ -449,49 +340,3 @@ int ksem_unlink(const char *name) {
 
     return 0;
 }
-
-// Remueve un proceso de todas las colas de espera de semáforos
-void ksem_remove_waiters_for(pcb_t *proc) {
-    if (proc == NULL) {
-        return;
-    }
-
-    sem_waiter_t *garbage_head = NULL;
-    sem_waiter_t *garbage_tail = NULL;
-
-    uint64_t flags = irq_save();
-
-    for (int bucket = 0; bucket < KSEM_HASH_BUCKETS; bucket++) {
-        ksem_t *sem = sem_buckets[bucket];
-        while (sem != NULL) {
-            ksem_t *next_sem = sem->hash_next;
-
-            uint64_t lock_flags = spinlock_lock_irqsave(&sem->lock);
-            sem_waiter_t *removed = wait_queue_remove_proc(&sem->waiters, proc);
-            spinlock_unlock_irqrestore(&sem->lock, lock_flags);
-
-            while (removed != NULL) {
-                sem_waiter_t *next = removed->next;
-                removed->next = NULL;
-                if (garbage_tail == NULL) {
-                    garbage_head = removed;
-                    garbage_tail = removed;
-                } else {
-                    garbage_tail->next = removed;
-                    garbage_tail = removed;
-                }
-                removed = next;
-            }
-
-            sem = next_sem;
-        }
-    }
-
-    irq_restore(flags);
-
-    while (garbage_head != NULL) {
-        sem_waiter_t *next = garbage_head->next;
-        mm_free(garbage_head);
-        garbage_head = next;
-    }
-}
@@ -0,0 +1,145 @@
+#include "wait_queue.h"
+#include "sched.h"
+#include "spinlock.h"
+
+// Implementación de las colas de espera FIFO con nodos embebidos
+
+static uint64_t irq_save(void);
+static void irq_restore(uint64_t flags);
+
+static uint64_t irq_save(void) {
+    uint64_t flags;
+    __asm__ volatile("pushfq\n\tpop %0" : "=r"(flags));
+    _cli();
+    return flags;
+}
+
+static void irq_restore(uint64_t flags) {
+    if (flags & (1ULL << 9)) {
+        _sti();
+    }
+}
+
+void wait_queue_init(wait_queue_t *q, struct spinlock *lock) {
+    if (q == NULL) {
+        return;
+    }
+    q->head = NULL;
+    q->tail = NULL;
+    q->lock = lock;
+}
+
+bool wait_queue_empty(const wait_queue_t *q) {
+    return q == NULL || __atomic_load_n(&q->head, __ATOMIC_RELAXED) == NULL;
+}
+
+void wait_queue_add(wait_queue_t *q, wait_node_t *node, pcb_t *proc) {
+    if (q == NULL || node == NULL) {
+        return;
+    }
+
+    // Un nodo que sigue encolado se saca antes de reencolarlo: pisar sus
+    // enlaces dejaría un ciclo (node->next == node) o la lista cortada.
+    // Si la otra cola usa el mismo lock ya lo tenemos tomado
+    wait_queue_t *old = node->queue;
+    if (old == q || (old != NULL && old->lock == q->lock)) {
+        wait_queue_remove(old, node);
+    } else if (old != NULL) {
+        wait_queue_detach(node);
+    }
+
+    node->proc = proc;
+    node->next = NULL;
+    node->queue = q;
+
+    if (q->tail == NULL) {
+        q->head = node;
+        q->tail = node;
+    } else {
+        q->tail->next = node;
+        q->tail = node;
+    }
+}
+
+// Retorna true si el nodo estaba encolado en q
+bool wait_queue_remove(wait_queue_t *q, wait_node_t *node) {
+    if (q == NULL || node == NULL || node->queue != q) {
+        return false;
+    }
+
+    wait_node_t *prev = NULL;
+    wait_node_t *cursor = q->head;
+    while (cursor != NULL && cursor != node) {
+        prev = cursor;
+        cursor = cursor->next;
+    }
+    if (cursor == NULL) {
+        return false;
+    }
+
+    if (prev == NULL) {
+        q->head = node->next;
+    } else {
+        prev->next = node->next;
+    }
+    if (q->tail == node) {
+        q->tail = prev;
+    }
+
+    node->next = NULL;
+    node->queue = NULL;
+    return true;
+}
+
+pcb_t *wait_queue_pop(wait_queue_t *q) {
+    if (q == NULL || q->head == NULL) {
+        return NULL;
+    }
+
+    wait_node_t *node = q->head;
+    q->head = node->next;
+    if (q->head == NULL) {
+        q->tail = NULL;
+    }
+
+    node->next = NULL;
+    node->queue = NULL;
+    return node->proc;
+}
+
+pcb_t *wait_queue_wake_one(wait_queue_t *q) {
+    pcb_t *proc = wait_queue_pop(q);
+    if (proc != NULL) {
+        proc_unblock(proc->pid);
+    }
+    return proc;
+}
+
+int wait_queue_wake_all(wait_queue_t *q) {
+    int woken = 0;
+    pcb_t *proc;
+    while ((proc = wait_queue_pop(q)) != NULL) {
+        proc_unblock(proc->pid);
+        woken++;
+    }
+    return woken;
+}
+
+void wait_queue_detach(wait_node_t *node) {
+    if (node == NULL) {
+        return;
+    }
+
+    uint64_t flags = irq_save();
+    wait_queue_t *q = node->queue;
+    if (q != NULL) {
+        if (q->lock != NULL) {
+            spinlock_lock(q->lock);
+        }
+        wait_queue_remove(q, node);
+        if (q->lock != NULL) {
+            spinlock_unlock(q->lock);
+        }
+    }
+    irq_restore(flags);
+}
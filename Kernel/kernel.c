@@ -10,6 +10,9 @@
 #include "memory_manager.h"
 #include "sched.h"
 #include "fd.h"
+#include "klog.h"
+#include "serial.h"
+#include "kdata.h"
 
 // Punto de entrada del kernel: inicializa subsistemas básicos y arranca userland
 
@@ -69,6 +72,21 @@ void * initializeKernelBinary()
 
 int main()
 { 
+	// Todo el kernel copia con memcpy/memset/memmove: se prueban antes que nada
+	int memFailures = memSelfCheck();
+
+	// Back buffer de video antes de cualquier dibujo
+	vDriver_init();
+	if (memFailures != 0) {
+		vDriver_prints("\nKERNEL: memcpy/memset/memmove self-check FAILED\n", WHITE, BLACK);
+	}
+
+	// COM1 antes de habilitar interrupciones; desde acá el log también sale por serie
+	serial_init();
+
+	// Página de PID/tiempo para userland, antes del primer tick
+	kdata_init();
+
 	load_idt();
 
 	// Inicializar el memory manager
@@ -76,6 +94,7 @@ int main()
 	void* heap_start = (void*)((uint64_t)&endOfKernel + PageSize * 8);
 	size_t heap_size = 4 * 1024 * 1024; // 4MB de heap para stacks y procesos
 	mm_init(heap_start, heap_size);
+	printk(KLOG_INFO, "mm: heap at %p, %u bytes", heap_start, (unsigned int)heap_size);
 
 	// Inicializar sistema de file descriptors (Hito 5)
 	fd_init();
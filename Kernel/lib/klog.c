@@ -0,0 +1,213 @@
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <klog.h>
+#include <time.h>
+
+// Ring de registros de tamaño fijo. Un escritor reserva su número de
+// secuencia con un fetch_add y publica el registro guardando seq + 1 en
+// el slot cuando terminó de escribirlo. No hay lock: printk se puede
+// llamar desde un handler de interrupción. Un lector que encuentra un
+// slot sin publicar o pisado por un escritor más nuevo lo saltea.
+
+typedef struct {
+    volatile uint64_t commit;  // seq + 1 cuando el registro está completo
+    uint64_t ticks;
+    uint8_t level;
+    uint8_t len;
+    char text[KLOG_LINE_MAX];
+} klog_entry_t;
+
+typedef struct {
+    char *buf;
+    int len;
+    int size;
+} klog_sink_t;
+
+static klog_entry_t entries[KLOG_ENTRIES];
+static uint64_t next_seq = 0;
+static int klog_level = KLOG_INFO;
+static klog_sink_fn klog_sink = NULL;
+
+static void sink_put(klog_sink_t *out, char c);
+static void sink_puts(klog_sink_t *out, const char *str);
+static void sink_num(klog_sink_t *out, uint64_t value, unsigned base, bool negative);
+static void klog_format(klog_sink_t *out, const char *fmt, va_list args);
+static int format_entry(const klog_entry_t *entry, char *dst, int size);
+
+static void sink_put(klog_sink_t *out, char c) {
+    if (out->len < out->size) {
+        out->buf[out->len++] = c;
+    }
+}
+
+static void sink_puts(klog_sink_t *out, const char *str) {
+    if (str == NULL) {
+        str = "(null)";
+    }
+    while (*str) {
+        sink_put(out, *str++);
+    }
+}
+
+static void sink_num(klog_sink_t *out, uint64_t value, unsigned base, bool negative) {
+    char digits[24];
+    int n = 0;
+    do {
+        digits[n++] = "0123456789abcdef"[value % base];
+        value /= base;
+    } while (value > 0);
+    if (negative) {
+        sink_put(out, '-');
+    }
+    while (n > 0) {
+        sink_put(out, digits[--n]);
+    }
+}
+
+static void klog_format(klog_sink_t *out, const char *fmt, va_list args) {
+    while (*fmt) {
+        if (*fmt != '%') {
+            sink_put(out, *fmt++);
+            continue;
+        }
+        fmt++;
+        bool is_long = false;
+        if (*fmt == 'l') {
+            is_long = true;
+            fmt++;
+        }
+
+        switch (*fmt) {
+        case 'd':
+        case 'i': {
+            int64_t v = is_long ? va_arg(args, int64_t) : va_arg(args, int);
+            sink_num(out, v < 0 ? (uint64_t)-v : (uint64_t)v, 10, v < 0);
+            break;
+        }
+        case 'u':
+            sink_num(out, is_long ? va_arg(args, uint64_t) : va_arg(args, unsigned int), 10, false);
+            break;
+        case 'x':
+            sink_num(out, is_long ? va_arg(args, uint64_t) : va_arg(args, unsigned int), 16, false);
+            break;
+        case 'p':
+            sink_puts(out, "0x");
+            sink_num(out, (uint64_t)(uintptr_t)va_arg(args, void *), 16, false);
+            break;
+        case 's':
+            sink_puts(out, va_arg(args, const char *));
+            break;
+        case 'c':
+            sink_put(out, (char)va_arg(args, int));
+            break;
+        case '%':
+            sink_put(out, '%');
+            break;
+        case '\0':
+            return;
+        default:
+            break;
+        }
+        fmt++;
+    }
+}
+
+void printk(int level, const char *fmt, ...) {
+    if (level > klog_level || fmt == NULL) {
+        return;
+    }
+
+    uint64_t seq = __atomic_fetch_add(&next_seq, 1, __ATOMIC_RELAXED);
+    klog_entry_t *entry = &entries[seq & (KLOG_ENTRIES - 1)];
+
+    __atomic_store_n(&entry->commit, 0, __ATOMIC_RELAXED);
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+
+    klog_sink_t out = {entry->text, 0, KLOG_LINE_MAX};
+    va_list args;
+    va_start(args, fmt);
+    klog_format(&out, fmt, args);
+    va_end(args);
+
+    // El salto de línea lo agrega el lector
+    while (out.len > 0 && entry->text[out.len - 1] == '\n') {
+        out.len--;
+    }
+    entry->len = (uint8_t)out.len;
+    entry->level = (uint8_t)level;
+    entry->ticks = ticks_elapsed();
+
+    __atomic_store_n(&entry->commit, seq + 1, __ATOMIC_RELEASE);
+
+    if (klog_sink != NULL) {
+        char line[KLOG_LINE_MAX + 32];
+        klog_sink(line, format_entry(entry, line, sizeof(line)));
+    }
+}
+
+void klog_set_sink(klog_sink_fn sink) {
+    klog_sink = sink;
+}
+
+int klog_get_level(void) {
+    return klog_level;
+}
+
+void klog_set_level(int level) {
+    if (level < KLOG_ERR) {
+        level = KLOG_ERR;
+    } else if (level > KLOG_DEBUG) {
+        level = KLOG_DEBUG;
+    }
+    klog_level = level;
+}
+
+static int format_entry(const klog_entry_t *entry, char *dst, int size) {
+    klog_sink_t out = {dst, 0, size};
+    sink_put(&out, '[');
+    sink_num(&out, entry->ticks, 10, false);
+    sink_puts(&out, "] ");
+    sink_num(&out, entry->level, 10, false);
+    sink_put(&out, ' ');
+    for (int i = 0; i < entry->len; i++) {
+        sink_put(&out, entry->text[i]);
+    }
+    sink_put(&out, '\n');
+    return out.len;
+}
+
+int klog_read(uint64_t *seq, char *buf, int size) {
+    if (seq == NULL || buf == NULL || size <= 0) {
+        return -1;
+    }
+
+    uint64_t last = __atomic_load_n(&next_seq, __ATOMIC_ACQUIRE);
+    uint64_t cur = *seq;
+    if (last > KLOG_ENTRIES && cur < last - KLOG_ENTRIES) {
+        cur = last - KLOG_ENTRIES;  // lo más viejo ya fue pisado
+    }
+
+    int written = 0;
+    char line[KLOG_LINE_MAX + 32];
+    for (; cur < last; cur++) {
+        const klog_entry_t *entry = &entries[cur & (KLOG_ENTRIES - 1)];
+        if (__atomic_load_n(&entry->commit, __ATOMIC_ACQUIRE) != cur + 1) {
+            continue;  // todavía escribiéndose o ya reemplazado
+        }
+        int len = format_entry(entry, line, sizeof(line));
+        if (__atomic_load_n(&entry->commit, __ATOMIC_ACQUIRE) != cur + 1) {
+            continue;  // lo pisaron mientras se copiaba
+        }
+        if (written + len > size) {
+            break;
+        }
+        for (int i = 0; i < len; i++) {
+            buf[written + i] = line[i];
+        }
+        written += len;
+    }
+
+    *seq = cur;
+    return written;
+}
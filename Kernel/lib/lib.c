@@ -1,13 +1,175 @@
 #include <stdint.h>
+#include <lib.h>
+
+// CPUID hoja 7 (subhoja 0): soporte de rep movsb/stosb rápidos
+#define CPUID_EBX_ERMS (1u << 9)
+#define CPUID_EDX_FSRM (1u << 4)
+
+#define MEM_FEAT_UNKNOWN 0x80000000u
+
+// Con ERMS pero sin FSRM, rep movsb/stosb tiene un costo de arranque que
+// no se amortiza en bloques chicos
+#define REP_MIN_LENGTH 128
+
+// Accesos de 64/32 bits sin requisito de alineación
+typedef uint64_t __attribute__((may_alias, aligned(1))) u64_unaligned;
+typedef uint32_t __attribute__((may_alias, aligned(1))) u32_unaligned;
+
+// Inicializada distinta de cero para que quede en .data: memset se usa
+// para limpiar .bss antes de que exista cualquier otro estado
+static uint32_t memFeatures = MEM_FEAT_UNKNOWN;
+
+// Autochequeo: largos 0..CHECK_SHORT_MAX y algunos que pasan por rep movsb/stosb,
+// con corrimientos de origen y destino entre 0 y CHECK_OFFSETS - 1
+#define CHECK_SHORT_MAX 64
+#define CHECK_OFFSETS   16
+#define CHECK_GUARD     16
+#define CHECK_MAX_LEN   300
+#define CHECK_BUF       (2 * CHECK_GUARD + CHECK_OFFSETS + CHECK_MAX_LEN)
+
+static const uint16_t checkLongLengths[] = {REP_MIN_LENGTH - 1, REP_MIN_LENGTH, REP_MIN_LENGTH + 1, CHECK_MAX_LEN};
+static const uint32_t checkModes[] = {0, MEM_FEAT_ERMS, MEM_FEAT_ERMS | MEM_FEAT_FSRM};
+
+static uint8_t checkSrc[CHECK_BUF];
+static uint8_t checkDst[CHECK_BUF];
+static uint8_t checkRef[CHECK_BUF];
+
+static uint32_t detectMemFeatures(void);
+static void copySmall(uint8_t *d, const uint8_t *s, uint64_t length);
+static void copyQwords(uint8_t *d, const uint8_t *s, uint64_t length);
+static void copyBackward(uint8_t *d, const uint8_t *s, uint64_t length);
+static void fillSmall(uint8_t *d, uint64_t pattern, uint64_t length);
+static void checkFill(uint8_t *buf, uint64_t span, uint8_t seed);
+static int checkEqual(uint64_t span);
+static int checkCase(uint64_t length, uint64_t srcOff, uint64_t dstOff);
+
+static inline uint64_t load64(const uint8_t *p) { return *(const u64_unaligned *)p; }
+static inline void store64(uint8_t *p, uint64_t v) { *(u64_unaligned *)p = v; }
+static inline uint32_t load32(const uint8_t *p) { return *(const u32_unaligned *)p; }
+static inline void store32(uint8_t *p, uint32_t v) { *(u32_unaligned *)p = v; }
+
+static uint32_t detectMemFeatures(void)
+{
+	uint32_t a, b, c, d;
+	uint32_t features = 0;
+
+	__asm__ volatile("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(0), "c"(0));
+	if (a >= 7) {
+		__asm__ volatile("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "a"(7), "c"(0));
+		if (b & CPUID_EBX_ERMS)
+			features |= MEM_FEAT_ERMS;
+		if (d & CPUID_EDX_FSRM)
+			features |= MEM_FEAT_FSRM;
+	}
+	return features;
+}
+
+uint32_t memCpuFeatures(void)
+{
+	if (memFeatures == MEM_FEAT_UNKNOWN)
+		memFeatures = detectMemFeatures();
+	return memFeatures;
+}
+
+// Hasta 16 bytes: dos accesos solapados cubren cualquier largo. Todas las
+// lecturas se hacen antes de escribir, así que sirve también para memmove
+static void copySmall(uint8_t *d, const uint8_t *s, uint64_t length)
+{
+	if (length >= 8) {
+		uint64_t head = load64(s);
+		uint64_t tail = load64(s + length - 8);
+		store64(d, head);
+		store64(d + length - 8, tail);
+	} else if (length >= 4) {
+		uint32_t head = load32(s);
+		uint32_t tail = load32(s + length - 4);
+		store32(d, head);
+		store32(d + length - 4, tail);
+	} else if (length > 0) {
+		uint8_t first = s[0];
+		uint8_t middle = s[length >> 1];
+		uint8_t last = s[length - 1];
+		d[0] = first;
+		d[length >> 1] = middle;
+		d[length - 1] = last;
+	}
+}
+
+// length >= 8. Cabeza y cola con accesos de 64 bits no alineados y el
+// cuerpo con rep movsq sobre el destino alineado a 8
+static void copyQwords(uint8_t *d, const uint8_t *s, uint64_t length)
+{
+	uint64_t tail = load64(s + length - 8);
+	uint8_t *end = d + length;
+
+	store64(d, load64(s));
+	uint64_t skip = 8 - ((uintptr_t)d & 7);
+	d += skip;
+	s += skip;
+	length -= skip;
+
+	uint64_t qwords = length >> 3;
+	__asm__ volatile("rep movsq" : "+D"(d), "+S"(s), "+c"(qwords) : : "memory");
+
+	store64(end - 8, tail);
+}
+
+// Copia de atrás hacia adelante para destinos que solapan por encima del origen
+static void copyBackward(uint8_t *d, const uint8_t *s, uint64_t length)
+{
+	if ((uintptr_t)(d - s) < 8) {
+		while (length--)
+			d[length] = s[length];
+		return;
+	}
+
+	uint64_t head = load64(s);
+	while (length >= 8) {
+		length -= 8;
+		store64(d + length, load64(s + length));
+	}
+	if (length > 0)
+		store64(d, head);
+}
+
+static void fillSmall(uint8_t *d, uint64_t pattern, uint64_t length)
+{
+	if (length >= 8) {
+		store64(d, pattern);
+		store64(d + length - 8, pattern);
+	} else if (length >= 4) {
+		store32(d, (uint32_t)pattern);
+		store32(d + length - 4, (uint32_t)pattern);
+	} else {
+		while (length--)
+			d[length] = (uint8_t)pattern;
+	}
+}
 
 // Llena un bloque de memoria con un valor específico
 void * memset(void * destination, int32_t c, uint64_t length)
 {
-	uint8_t chr = (uint8_t)c;
-	char * dst = (char*)destination;
+	uint8_t *d = (uint8_t *)destination;
+	uint64_t pattern = (uint8_t)c * 0x0101010101010101ULL;
 
-	while(length--)
-		dst[length] = chr;
+	if (length <= 16) {
+		fillSmall(d, pattern, length);
+		return destination;
+	}
+
+	uint32_t features = memCpuFeatures();
+	if ((features & MEM_FEAT_ERMS) && length >= REP_MIN_LENGTH) {
+		__asm__ volatile("rep stosb" : "+D"(d), "+c"(length) : "a"((uint8_t)c) : "memory");
+		return destination;
+	}
+
+	uint8_t *end = d + length;
+	store64(d, pattern);
+	uint64_t skip = 8 - ((uintptr_t)d & 7);
+	d += skip;
+	uint64_t qwords = (length - skip) >> 3;
+	__asm__ volatile("rep stosq" : "+D"(d), "+c"(qwords) : "a"(pattern) : "memory");
+	store64(end - 8, pattern);
 
 	return destination;
 }
@@ -15,29 +177,144 @@ void * memset(void * destination, int32_t c, uint64_t length)
 // Copia un bloque de memoria desde source hacia destination
 void * memcpy(void * destination, const void * source, uint64_t length)
 {
-	
-	uint64_t i;
+	uint8_t *d = (uint8_t *)destination;
+	const uint8_t *s = (const uint8_t *)source;
 
-	if ((uint64_t)destination % sizeof(uint32_t) == 0 &&
-		(uint64_t)source % sizeof(uint32_t) == 0 &&
-		length % sizeof(uint32_t) == 0)
-	{
-		uint32_t *d = (uint32_t *) destination;
-		const uint32_t *s = (const uint32_t *)source;
+	if (length <= 16) {
+		copySmall(d, s, length);
+		return destination;
+	}
 
-		for (i = 0; i < length / sizeof(uint32_t); i++)
-			d[i] = s[i];
+	uint32_t features = memCpuFeatures();
+	if ((features & MEM_FEAT_FSRM) || ((features & MEM_FEAT_ERMS) && length >= REP_MIN_LENGTH)) {
+		__asm__ volatile("rep movsb" : "+D"(d), "+S"(s), "+c"(length) : : "memory");
+		return destination;
+	}
+
+	copyQwords(d, s, length);
+	return destination;
+}
+
+// Como memcpy, pero admite que origen y destino se solapen
+void * memmove(void * destination, const void * source, uint64_t length)
+{
+	uint8_t *d = (uint8_t *)destination;
+	const uint8_t *s = (const uint8_t *)source;
+
+	if (d == s || length == 0)
+		return destination;
+
+	if (length <= 16) {
+		copySmall(d, s, length);
+		return destination;
 	}
-	else
-	{
-		uint8_t * d = (uint8_t*)destination;
-		const uint8_t * s = (const uint8_t*)source;
 
-		for (i = 0; i < length; i++)
+	if (d > s && d < s + length) {
+		copyBackward(d, s, length);
+		return destination;
+	}
+
+	// Hacia adelante con el destino a menos de 8 bytes del origen, la
+	// cabeza de 64 bits de copyQwords pisaría bytes aún no leídos
+	if (d < s && (uintptr_t)(s - d) < 8) {
+		for (uint64_t i = 0; i < length; i++)
 			d[i] = s[i];
+		return destination;
 	}
 
-	return destination;
+	return memcpy(destination, source, length);
+}
+
+static void checkFill(uint8_t *buf, uint64_t span, uint8_t seed)
+{
+	for (uint64_t i = 0; i < span; i++)
+		buf[i] = (uint8_t)(i * 7 + seed);
+}
+
+static int checkEqual(uint64_t span)
+{
+	for (uint64_t i = 0; i < span; i++) {
+		if (checkDst[i] != checkRef[i])
+			return 1;
+	}
+	return 0;
+}
+
+// Un largo y un par de corrimientos contra copias byte a byte. Los bytes de
+// guarda alrededor del destino tienen que quedar intactos
+static int checkCase(uint64_t length, uint64_t srcOff, uint64_t dstOff)
+{
+	uint64_t span = 2 * CHECK_GUARD + CHECK_OFFSETS + length;
+	uint64_t s = CHECK_GUARD + srcOff;
+	uint64_t d = CHECK_GUARD + dstOff;
+	int failures = 0;
+
+	checkFill(checkSrc, span, 1);
+	checkFill(checkDst, span, 2);
+	checkFill(checkRef, span, 2);
+	for (uint64_t i = 0; i < length; i++)
+		checkRef[d + i] = checkSrc[s + i];
+	memcpy(checkDst + d, checkSrc + s, length);
+	failures += checkEqual(span);
+
+	// memset solo depende del destino
+	if (srcOff == 0) {
+		checkFill(checkDst, span, 2);
+		for (uint64_t i = 0; i < length; i++)
+			checkRef[d + i] = 0xA5;
+		memset(checkDst + d, 0xA5, length);
+		failures += checkEqual(span);
+	}
+
+	// memmove dentro del mismo buffer: según los corrimientos solapa hacia
+	// adelante, hacia atrás o coincide. La referencia lee todo antes de escribir
+	checkFill(checkDst, span, 3);
+	checkFill(checkRef, span, 3);
+	for (uint64_t i = 0; i < length; i++)
+		checkSrc[i] = checkRef[s + i];
+	for (uint64_t i = 0; i < length; i++)
+		checkRef[d + i] = checkSrc[i];
+	memmove(checkDst + d, checkDst + s, length);
+	failures += checkEqual(span);
+
+	return failures;
+}
+
+// Prueba memcpy/memset/memmove en cada camino (qwords, ERMS y ERMS+FSRM) sin
+// importar lo que soporte el CPU. Retorna la cantidad de casos que fallaron
+int memSelfCheck(void)
+{
+	uint32_t detected = memCpuFeatures();
+	int failures = 0;
+
+	for (uint64_t m = 0; m < sizeof(checkModes) / sizeof(checkModes[0]); m++) {
+		memFeatures = checkModes[m];
+		for (uint64_t s = 0; s < CHECK_OFFSETS; s++) {
+			for (uint64_t d = 0; d < CHECK_OFFSETS; d++) {
+				for (uint64_t length = 0; length <= CHECK_SHORT_MAX; length++)
+					failures += checkCase(length, s, d);
+				for (uint64_t i = 0; i < sizeof(checkLongLengths) / sizeof(checkLongLengths[0]); i++)
+					failures += checkCase(checkLongLengths[i], s, d);
+			}
+		}
+	}
+
+	memFeatures = detected;
+	return failures;
+}
+
+// Bucket de un histograma log2: el k cubre [2^(k+shift), 2^(k+shift+1)); el
+// primero también junta los valores menores y el último los mayores
+int log2_bucket(uint64_t value, int shift, int buckets)
+{
+	int bucket = 0;
+	if (value != 0)
+		bucket = 63 - __builtin_clzll(value) - shift;
+	if (bucket < 0)
+		return 0;
+	if (bucket >= buckets)
+		return buckets - 1;
+	return bucket;
 }
 
 // Compara dos cadenas de texto y retorna 0 si son iguales
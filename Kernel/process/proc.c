@@ -5,7 +5,8 @@
 #include "fd.h"
 #include "semaphore.h"
 #include "syscalls.h"
-#include "naiveConsole.h"
+#include "klog.h"
+#include "poll.h"
 
 #define KSTACK_SIZE (16 * 1024)  // Tamaño del stack del kernel por proceso
 
@@ -46,6 +47,7 @@ static pcb_t *find_child(pcb_t *parent, int child_pid);
 static bool parent_has_children(pcb_t *parent);
 static void cleanup_wait_results(pcb_t *proc);
 static void detach_children(pcb_t *parent);
+static void free_user_tls(pcb_t *proc);
 
 extern void _hlt(void);
 
@@ -82,7 +84,8 @@ int proc_create(void (*entry)(int, char **), int argc, char **argv,
     proc->aging_ticks = 0;
     proc->state = NEW;
     proc->fg = fg;
-    proc->ticks_left = TIME_SLICE_TICKS;  // Quantum inicial
+    proc->ticks_left = sched_quantum_ticks(prio);  // Quantum inicial
+    proc->slice_left = 0;
     proc->parent_pid = -1;
     proc->entry = entry;  // Puntero a función de userland
     proc->argc = argc;
@@ -148,17 +151,7 @@ int proc_create(void (*entry)(int, char **), int argc, char **argv,
 
     sched_enqueue(proc);
 
-    ncPrint("[KERNEL proc_create] Created process PID=");
-    ncPrintDec(proc->pid);
-    ncPrint(" prio=");
-    ncPrintDec(proc->priority);
-    ncPrint(" name=");
-    ncPrint(proc->name);
-    ncNewline();
-    if (proc->name[0] == 'p' && proc->name[1] == 's' && proc->name[2] == '\0') {
-        ncPrint("[KERNEL proc_create] -> ps command scheduled\n");
-        ncNewline();
-    }
+    printk(KLOG_DEBUG, "proc_create: pid=%d prio=%d name=%s", proc->pid, proc->priority, proc->name);
 
     // Si el proceso se crea como foreground, actualizar la TTY
     if (fg) {
@@ -179,10 +172,7 @@ void proc_exit(int code) {
         return;
     }
 
-    ksem_remove_waiters_for(proc);
-
-    // Liberar todos los handles de semáforos que este proceso abrió
-    sem_cleanup_process_handles(proc->pid);
+    wait_queue_detach(&proc->wait_node);
 
     // Si este proceso era el foreground, liberar la TTY
     if (proc->fg) {
@@ -211,6 +201,7 @@ void proc_exit(int code) {
         fd_table_destroy(proc->fd_table);
         proc->fd_table = NULL;
     }
+    free_user_tls(proc);
     cleanup_wait_results(proc);
     enqueue_zombie(proc);
 
@@ -267,8 +258,11 @@ int proc_unblock(int pid) {
     }
 
     if (proc->state == BLOCKED) {
+        // Si lo despiertan desde fuera de su cola (sys_unblock) el nodo
+        // sigue encolado; al volver a bloquearse se reencolaría encima
+        wait_queue_detach(&proc->wait_node);
         proc->state = READY;
-        proc->ticks_left = TIME_SLICE_TICKS;
+        proc->ticks_left = sched_quantum_ticks(proc->base_priority);
         proc->aging_ticks = 0;
         sched_enqueue(proc);
         return 0;
@@ -340,7 +334,9 @@ int proc_kill(int pid) {
         return -1;
     }
 
-    ksem_remove_waiters_for(target);
+    wait_queue_detach(&target->wait_node);
+    poll_cancel(target);
+    sched_cancel_timeout(target);
 
     // Si el proceso a matar es foreground, devolver control al padre
     // No desbloqueamos manualmente al padre porque notify_parent_exit lo hara
@@ -394,6 +390,7 @@ int proc_kill(int pid) {
         fd_table_destroy(target->fd_table);
         target->fd_table = NULL;
     }
+    free_user_tls(target);
     cleanup_wait_results(target);
     enqueue_zombie(target);
     collect_zombies();
@@ -485,6 +482,15 @@ static void release_slot(pcb_t *proc) {
     proc->used = false;
 }
 
+// Libera el estado de userland asignado con sys_tls_alloc
+static void free_user_tls(pcb_t *proc) {
+    if (proc->user_tls != NULL) {
+        mm_free(proc->user_tls);
+        proc->user_tls = NULL;
+    }
+    proc->exit_hook = NULL;
+}
+
 // Configura el stack inicial del proceso con los registros necesarios
 static void setup_stack(pcb_t *proc) {
     uint64_t top = (uint64_t)proc->kstack_base + KSTACK_SIZE;
@@ -596,29 +602,23 @@ static void copy_name(char *dst, const char *src, size_t max_len) {
 
 // Función de trampolín que ejecuta la función de entrada del proceso
 static void trampoline(pcb_t *proc) {
-    ncPrint("[KERNEL trampoline] Entered!\n");
-    if (proc != NULL) {
-        ncPrint("[KERNEL trampoline] proc name: ");
-        ncPrint(proc->name);
-        ncNewline();
-    }
     if (proc == NULL) {
-        ncPrint("[KERNEL trampoline] ERROR: proc is NULL\n");
+        printk(KLOG_ERR, "trampoline: proc is NULL");
         proc_exit(-1);
         while (1) _hlt();
     }
     if (proc->entry == NULL) {
-        ncPrint("[KERNEL trampoline] ERROR: entry is NULL\n");
+        printk(KLOG_ERR, "trampoline: pid=%d has no entry", proc->pid);
         proc_exit(-1);
         while (1) _hlt();
     }
-    ncPrint("[KERNEL trampoline] Calling entry...\n");
-    if (proc->name[0] == 'p' && proc->name[1] == 's' && proc->name[2] == '\0') {
-        ncPrint("[KERNEL trampoline] Calling ps entry\n");
-        ncNewline();
-    }
+    printk(KLOG_DEBUG, "trampoline: pid=%d name=%s", proc->pid, proc->name);
     proc->entry(proc->argc, proc->argv);
-    ncPrint("[KERNEL trampoline] Entry returned, exiting...\n");
+    printk(KLOG_DEBUG, "trampoline: pid=%d entry returned", proc->pid);
+    // Retorno normal de entry: userland vacía sus buffers (stdio)
+    if (proc->exit_hook != NULL) {
+        proc->exit_hook();
+    }
     proc_exit(0);
     while (1) {
         _hlt();
@@ -1,5 +1,10 @@
 #include "sched.h"
 #include "naiveConsole.h"
+#include "time.h"
+#include "kdata.h"
+#include "irqoff.h"
+#include "irqtrace.h"
+#include "interrupts.h"
 
 // Colas FIFO de procesos READY, una por cada nivel de prioridad
 static pcb_t *ready_head[MAX_PRIOS];
@@ -7,12 +12,26 @@ static pcb_t *ready_tail[MAX_PRIOS];
 
 static bool scheduler_enabled = false;
 
-// Umbral de aging: ticks que un proceso debe esperar antes de ser promovido
-#define AGING_THRESHOLD 10
+// Umbral de aging: tiempo que un proceso debe esperar antes de ser promovido
+#define AGING_THRESHOLD_MS 500
+#define AGING_THRESHOLD ((AGING_THRESHOLD_MS * TICK_HZ + 999) / 1000)
+
+// Quantum de cada nivel de prioridad, en microsegundos; se convierte a
+// ticks según TICK_HZ. Los niveles altos (interactivos) cortan seguido
+// para responder rápido; los bajos (batch) cambian de contexto menos
+static const uint32_t quantum_us[MAX_PRIOS] = {
+    TIME_SLICE_US * 4,   // MIN_PRIO: 80 ms
+    TIME_SLICE_US * 2,
+    TIME_SLICE_US,       // DEFAULT_PRIO: 20 ms
+    TIME_SLICE_US / 2    // HIGHEST_PRIO: 10 ms
+};
 
 pcb_t *current = NULL;
 
 static pcb_t *idle_proc = NULL;
+
+// Procesos bloqueados con timeout, ordenados por tick de vencimiento
+static pcb_t *timeout_head = NULL;
 extern void _force_schedule(void);
 extern void _hlt(void);
 
@@ -21,7 +40,10 @@ static pcb_t *q_pop(int prio);
 static void q_remove(pcb_t *proc);
 static pcb_t *pick_next(void);
 static void apply_aging(void);
+static void wake_expired(void);
 static void idle_loop(int argc, char **argv);
+static uint64_t reschedule(uint64_t cur_rsp, bool tick);
+static int next_slice(pcb_t *proc);
 
 // Inicializa el scheduler (colas de prioridad y proceso idle)
 void sched_init(void) {
@@ -43,8 +65,9 @@ void sched_init(void) {
             // El idle solo debe ejecutarse cuando no hay otros procesos
             sched_remove(idle_proc);
             idle_proc->state = RUNNING;
-            idle_proc->ticks_left = TIME_SLICE_TICKS;
+            idle_proc->ticks_left = sched_quantum_ticks(MIN_PRIO);
             current = idle_proc;
+            kdata_set_pid(current->pid);
         }
     }
 }
@@ -78,7 +101,8 @@ void sched_enqueue(pcb_t *proc) {
     if (!scheduler_enabled && current == NULL) {
         current = proc;
         proc->state = RUNNING;
-        proc->ticks_left = TIME_SLICE_TICKS;
+        proc->ticks_left = sched_quantum_ticks(proc->base_priority);
+        kdata_set_pid(proc->pid);
         return;
     }
 
@@ -91,7 +115,7 @@ void sched_enqueue(pcb_t *proc) {
     // Ensure queue_next is clear before enqueueing
     proc->queue_next = NULL;
     proc->state = READY;
-    proc->ticks_left = TIME_SLICE_TICKS;
+    proc->ticks_left = sched_quantum_ticks(proc->base_priority);
     proc->aging_ticks = 0;
     q_push(proc);
 }
@@ -116,24 +140,117 @@ pcb_t *sched_pick_next(void) {
     return pick_next();
 }
 
+// Quantum del nivel en ticks; al menos uno aunque el tick sea más largo
+int sched_quantum_ticks(int prio) {
+    if (prio < MIN_PRIO) {
+        prio = MIN_PRIO;
+    } else if (prio > HIGHEST_PRIO) {
+        prio = HIGHEST_PRIO;
+    }
+    uint64_t ticks = us_to_ticks(quantum_us[prio]);
+    return ticks > 0 ? (int)ticks : 1;
+}
+
 // Fuerza un cambio de contexto inmediato
 void sched_force_yield(void) {
+    // Mientras no corre, el tramo con IF=0 de su syscall queda suspendido
+    irqoff_site_t *site = irqoff_pause();
     if (current != NULL) {
         current->ticks_left = 0;
     }
     _force_schedule();
+    irqoff_resume(site);
+}
+
+// Punto de preemption para syscalls largas: abre una ventana de una
+// instrucción con IF=1 para que entre el timer pendiente y, si venció el
+// quantum, corra otro proceso. Fuera de una syscall no hace nada. El
+// llamador no puede tener locks tomados ni estado a medio actualizar
+void sched_preempt_point(void) {
+    if (!irqoff_in_syscall()) {
+        return;
+    }
+    irqoff_site_t *site = irqoff_pause();
+    _sti();
+    __asm__ volatile("nop");
+    _cli();
+    irqoff_resume(site);
+}
+
+// Arma un timeout: si al llegar wake_tick el proceso sigue BLOCKED, vuelve a READY.
+// Llamar con interrupciones deshabilitadas.
+void sched_arm_timeout(pcb_t *proc, uint64_t wake_tick) {
+    if (proc == NULL) {
+        return;
+    }
+
+    sched_cancel_timeout(proc);
+    proc->wake_tick = wake_tick;
+
+    pcb_t **link = &timeout_head;
+    while (*link != NULL && (*link)->wake_tick <= wake_tick) {
+        link = &(*link)->timer_next;
+    }
+    proc->timer_next = *link;
+    *link = proc;
+}
+
+// Desarma el timeout de un proceso (no-op si no tenía)
+void sched_cancel_timeout(pcb_t *proc) {
+    if (proc == NULL || proc->wake_tick == 0) {
+        return;
+    }
+
+    pcb_t **link = &timeout_head;
+    while (*link != NULL && *link != proc) {
+        link = &(*link)->timer_next;
+    }
+    if (*link == proc) {
+        *link = proc->timer_next;
+    }
+    proc->timer_next = NULL;
+    proc->wake_tick = 0;
 }
 
 // Función principal del scheduler que ejecuta en cada tick del reloj
 uint64_t schedule(uint64_t cur_rsp) {
+    irqtrace_timer_schedule();
+    return reschedule(cur_rsp, true);
+}
+
+// Entrada desde sched_force_yield (vector 0x81): no consume slice
+uint64_t schedule_yield(uint64_t cur_rsp) {
+    return reschedule(cur_rsp, false);
+}
+
+// Con SCHED_KEEP_SLICE, quien cedió la CPU antes de agotar su slice retoma
+// lo que le quedaba (acotado al quantum de su nivel, por si cambió con nice)
+static int next_slice(pcb_t *proc) {
+    int quantum = sched_quantum_ticks(proc->base_priority);
+#if SCHED_KEEP_SLICE
+    if (proc->slice_left > 0 && proc->slice_left < quantum) {
+        return proc->slice_left;
+    }
+#endif
+    return quantum;
+}
+
+static uint64_t reschedule(uint64_t cur_rsp, bool tick) {
     if (!scheduler_enabled || current == NULL) {
         return 0;
     }
 
     current->kframe = (regs_t *)cur_rsp;
 
-    if (current->ticks_left > 0) {
-        current->ticks_left--;
+    wake_expired();
+
+    // Solo los ticks consumen slice: quien bloquea pone ticks_left en 0
+    // para forzar el cambio, pero slice_left conserva lo que le quedaba
+    if (tick) {
+        if (current->ticks_left > 0) {
+            current->ticks_left--;
+        }
+        current->slice_left = current->ticks_left;
     }
 
     if (current->ticks_left > 0 && current->state == RUNNING) {
@@ -145,7 +262,7 @@ uint64_t schedule(uint64_t cur_rsp) {
     // El idle process nunca se encola, siempre queda como fallback
     if (prev->state == RUNNING && prev != idle_proc) {
         prev->state = READY;
-        prev->ticks_left = TIME_SLICE_TICKS;
+        prev->ticks_left = sched_quantum_ticks(prev->base_priority);
         prev->priority = prev->base_priority;
         prev->aging_ticks = 0;
         q_push(prev);
@@ -179,12 +296,14 @@ uint64_t schedule(uint64_t cur_rsp) {
     }
 
     next->state = RUNNING;
-    next->ticks_left = TIME_SLICE_TICKS;
+    next->ticks_left = next_slice(next);
+    next->slice_left = next->ticks_left;
     if (next != idle_proc) {
         next->priority = next->base_priority;
         next->aging_ticks = 0;
     }
     current = next;
+    kdata_set_pid(current->pid);
 
     return (uint64_t)current->kframe;
 }
@@ -326,6 +445,20 @@ static void apply_aging(void) {
     }
 }
 
+// Despierta a los procesos cuyo timeout ya venció
+static void wake_expired(void) {
+    uint64_t now = ticks_elapsed();
+    while (timeout_head != NULL && timeout_head->wake_tick <= now) {
+        pcb_t *proc = timeout_head;
+        timeout_head = proc->timer_next;
+        proc->timer_next = NULL;
+        proc->wake_tick = 0;
+        if (proc->state == BLOCKED) {
+            sched_enqueue(proc);
+        }
+    }
+}
+
 // Función del proceso idle (se ejecuta cuando no hay otros procesos)
 static void idle_loop(int argc, char **argv) {
     (void)argc;
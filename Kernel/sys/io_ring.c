@@ -0,0 +1,95 @@
+#include <stddef.h>
+#include "io_ring.h"
+#include "syscalls.h"
+#include "sched.h"
+#include "errno.h"
+
+// Las operaciones se ejecutan en orden y de forma sincrónica dentro de
+// sys_io_ring_enter, con la misma semántica (y bloqueo) que su syscall.
+// Si el CQ se llena se deja de consumir el SQ: nunca se pierde un resultado
+
+#define IO_RING_PREEMPT_BATCH 16   // SQEs entre puntos de preemption
+
+static int64_t run_sqe(const io_sqe_t *sqe);
+
+static int64_t run_sqe(const io_sqe_t *sqe) {
+    switch (sqe->op) {
+    case IO_OP_NOP:
+        return 0;
+    case IO_OP_READ:
+        return sys_read(sqe->fd, (void *)sqe->addr, (int)sqe->len);
+    case IO_OP_WRITE:
+        return sys_write(sqe->fd, (const void *)sqe->addr, (int)sqe->len);
+    case IO_OP_SEM_POST:
+        return sys_sem_post(sqe->fd);
+    case IO_OP_PIPE_WRITE:
+        return sys_pipe_write(sqe->fd, (const void *)sqe->addr, (int)sqe->len);
+    default:
+        return E_INVAL;
+    }
+}
+
+// Registra el ring del proceso actual; NULL lo desregistra
+int sys_io_ring_setup(io_ring_t *ring) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL) {
+        return -1;
+    }
+    if (ring == NULL) {
+        cur->io_ring = NULL;
+        return 0;
+    }
+
+    uint32_t entries = ring->entries;
+    if (entries == 0 || entries > IO_RING_MAX_ENTRIES || (entries & (entries - 1)) != 0 ||
+        ring->sqes == NULL || ring->cqes == NULL) {
+        return E_INVAL;
+    }
+
+    ring->sq_head = ring->sq_tail = 0;
+    ring->cq_head = ring->cq_tail = 0;
+    cur->io_ring = ring;
+    return 0;
+}
+
+// Consume hasta to_submit sqes (to_submit < 0: todas las pendientes) y
+// devuelve cuántas se procesaron
+int sys_io_ring_enter(int to_submit) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL || cur->io_ring == NULL) {
+        return E_INVAL;
+    }
+
+    io_ring_t *ring = cur->io_ring;
+    uint32_t mask = ring->entries - 1;
+    uint32_t head = ring->sq_head;
+    uint32_t tail = __atomic_load_n(&ring->sq_tail, __ATOMIC_ACQUIRE);
+    uint32_t pending = tail - head;
+    if (pending > ring->entries) {
+        return E_INVAL;  // índices corruptos
+    }
+    if (to_submit >= 0 && (uint32_t)to_submit < pending) {
+        pending = (uint32_t)to_submit;
+    }
+
+    int done = 0;
+    while ((uint32_t)done < pending) {
+        uint32_t cq_tail = ring->cq_tail;
+        if (cq_tail - __atomic_load_n(&ring->cq_head, __ATOMIC_ACQUIRE) >= ring->entries) {
+            break;  // CQ lleno: userland tiene que cosechar primero
+        }
+
+        io_sqe_t sqe = ring->sqes[head & mask];
+        __atomic_store_n(&ring->sq_head, ++head, __ATOMIC_RELEASE);
+
+        io_cqe_t *cqe = &ring->cqes[cq_tail & mask];
+        cqe->user_data = sqe.user_data;
+        cqe->res = run_sqe(&sqe);
+        __atomic_store_n(&ring->cq_tail, cq_tail + 1, __ATOMIC_RELEASE);
+        done++;
+        if ((done % IO_RING_PREEMPT_BATCH) == 0) {
+            sched_preempt_point();  // índices ya publicados: estado consistente
+        }
+    }
+    return done;
+}
@@ -0,0 +1,106 @@
+#include <stddef.h>
+#include <stdint.h>
+#include "irqoff.h"
+#include "irqtrace.h"
+#include "tsc.h"
+
+// Todo corre con IF=0 (dentro de un sitio o en el sys_irqoff_stats que
+// los lee), no hace falta lock
+
+static irqoff_site_t *sites = NULL;
+static irqoff_site_t *open_site = NULL;
+static uint64_t open_start;
+
+static void close_section(void);
+
+static void close_section(void) {
+    uint64_t cycles = rdtsc() - open_start;
+    open_site->sections++;
+    open_site->total_cycles += cycles;
+    if (cycles > open_site->max_cycles) {
+        open_site->max_cycles = cycles;
+    }
+    open_site = NULL;
+}
+
+void irqoff_begin(irqoff_site_t *site) {
+    irqtrace_cut();
+    if (open_site != NULL) {
+        close_section();
+    }
+    if (!site->registered) {
+        site->registered = true;
+        site->next = sites;
+        sites = site;
+    }
+    site->count++;
+    open_site = site;
+    open_start = rdtsc();
+}
+
+void irqoff_end(void) {
+    if (open_site != NULL) {
+        close_section();
+    }
+}
+
+irqoff_site_t *irqoff_pause(void) {
+    irqtrace_cut();
+    irqoff_site_t *site = open_site;
+    if (site != NULL) {
+        close_section();
+    }
+    return site;
+}
+
+void irqoff_resume(irqoff_site_t *site) {
+    if (site == NULL) {
+        return;
+    }
+    irqtrace_cut();
+    if (open_site != NULL) {
+        close_section();
+    }
+    open_site = site;
+    open_start = rdtsc();
+}
+
+bool irqoff_in_syscall(void) {
+    return open_site != NULL && open_site->kind == IRQOFF_SYSCALL;
+}
+
+// READ copia hasta max sitios (los que corrieron al menos una vez) y
+// retorna cuántos; RESET pone los contadores en cero
+int irqoff_stats(int op, irqoff_stat_t *out, int max) {
+    if (op == IRQOFF_STATS_RESET) {
+        for (irqoff_site_t *s = sites; s != NULL; s = s->next) {
+            s->count = 0;
+            s->sections = 0;
+            s->total_cycles = 0;
+            s->max_cycles = 0;
+        }
+        return 0;
+    }
+    if (op != IRQOFF_STATS_READ || out == NULL || max <= 0) {
+        return -1;
+    }
+
+    int n = 0;
+    for (irqoff_site_t *s = sites; s != NULL && n < max; s = s->next) {
+        irqoff_stat_t *st = &out[n++];
+        int j = 0;
+        if (s->name != NULL) {
+            for (; j < IRQOFF_NAME_MAX - 1 && s->name[j] != 0; j++) {
+                st->name[j] = s->name[j];
+            }
+        }
+        st->name[j] = 0;
+        st->kind = s->kind;
+        st->reserved = 0;
+        st->count = s->count;
+        st->sections = s->sections;
+        st->total_cycles = s->total_cycles;
+        st->max_cycles = s->max_cycles;
+    }
+    return n;
+}
@@ -0,0 +1,119 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "irqtrace.h"
+#include "lib.h"
+#include "tsc.h"
+
+// Todo corre con IF=0: entre el cli y el sti que se miden, o dentro de
+// un handler o syscall. No hace falta lock
+
+static irqlat_stats_t stats;
+
+static bool section_open = false;
+static uint64_t section_start;
+static uint64_t section_cli_ip;
+static uint64_t section_cli_caller;
+
+static uint64_t timer_stamp = 0;
+static uint64_t kbd_stamp = 0;   // 0: no hay IRQ de teclado pendiente de medir
+
+static void close_section(uint64_t sti_ip);
+static void record_top(const irqlat_section_t *s);
+static void hist_account(irqlat_hist_t *h, uint64_t cycles);
+
+// Inserción en la tabla ordenada de los tramos más largos
+static void record_top(const irqlat_section_t *s) {
+    int i = IRQLAT_TOP - 1;
+    if (s->cycles <= stats.top[i].cycles) {
+        return;
+    }
+    while (i > 0 && stats.top[i - 1].cycles < s->cycles) {
+        stats.top[i] = stats.top[i - 1];
+        i--;
+    }
+    stats.top[i] = *s;
+}
+
+static void close_section(uint64_t sti_ip) {
+    irqlat_section_t s;
+    s.cycles = rdtsc() - section_start;
+    s.cli_ip = section_cli_ip;
+    s.cli_caller = section_cli_caller;
+    s.sti_ip = sti_ip;
+    section_open = false;
+
+    stats.sections++;
+    stats.total_cycles += s.cycles;
+    record_top(&s);
+}
+
+static void hist_account(irqlat_hist_t *h, uint64_t cycles) {
+    h->count++;
+    h->total_cycles += cycles;
+    if (cycles > h->max_cycles) {
+        h->max_cycles = cycles;
+    }
+    h->hist[log2_bucket(cycles, IRQLAT_HIST_SHIFT, IRQLAT_HIST_BUCKETS)]++;
+}
+
+// frame es el rbp de quien llamó a _cli: el kernel compila sin
+// -fomit-frame-pointer, así que frame[1] es su dirección de retorno
+void irqtrace_cli(uint64_t ip, const uint64_t *frame) {
+    section_start = rdtsc();
+    section_cli_ip = ip;
+    section_cli_caller = 0;
+    if (frame != NULL && ((uintptr_t)frame & 7) == 0) {
+        section_cli_caller = frame[1];
+    }
+    section_open = true;
+}
+
+// Un _sti sin tramo abierto habilita interrupciones deshabilitadas por
+// hardware (puerta de interrupción o SYSCALL): no es un tramo de _cli
+void irqtrace_sti(uint64_t ip) {
+    if (section_open) {
+        close_section(ip);
+    }
+}
+
+void irqtrace_cut(void) {
+    if (section_open) {
+        close_section(0);
+    }
+}
+
+void irqtrace_timer_entry(void) {
+    timer_stamp = rdtsc();
+}
+
+void irqtrace_timer_schedule(void) {
+    if (timer_stamp != 0) {
+        hist_account(&stats.timer, rdtsc() - timer_stamp);
+        timer_stamp = 0;
+    }
+}
+
+void irqtrace_kbd_entry(void) {
+    kbd_stamp = rdtsc();
+}
+
+// Soltar una tecla no llega a tty_push_char: la marca se pisa en el próximo IRQ
+void irqtrace_kbd_push(void) {
+    if (kbd_stamp != 0) {
+        hist_account(&stats.keyboard, rdtsc() - kbd_stamp);
+        kbd_stamp = 0;
+    }
+}
+
+int irqtrace_stats(int op, irqlat_stats_t *out) {
+    if (op == IRQLAT_STATS_RESET) {
+        memset(&stats, 0, sizeof(stats));
+        return 0;
+    }
+    if (op != IRQLAT_STATS_READ || out == NULL) {
+        return -1;
+    }
+    *out = stats;
+    return 0;
+}
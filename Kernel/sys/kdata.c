@@ -0,0 +1,66 @@
+#include <stdint.h>
+#include "kdata.h"
+#include "time.h"
+#include "lib.h"
+#include "tsc.h"
+
+// El RTC se relee cada ~250 ms: leerlo son varios accesos a puertos y el
+// reloj de pared solo tiene resolución de segundos
+#define KDATA_RTC_PERIOD ((TICK_HZ + 3) / 4)
+
+static kdata_page_t kdata __attribute__((aligned(KDATA_PAGE_SIZE)));
+
+static void write_begin(void);
+static void write_end(void);
+static void read_rtc(void);
+
+static void write_begin(void) {
+    kdata.seq++;
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+static void write_end(void) {
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+    kdata.seq++;
+}
+
+static void read_rtc(void) {
+    kdata.hours = (uint8_t)getHours();
+    kdata.minutes = (uint8_t)getMinutes();
+    kdata.seconds = (uint8_t)getSeconds();
+}
+
+void kdata_init(void) {
+    write_begin();
+    kdata.pid = 0;
+    kdata.ticks = 0;
+    kdata.uptime_ms = 0;
+    kdata.tick_tsc = rdtsc();
+    kdata.tick_hz = TICK_HZ;
+    read_rtc();
+    write_end();
+}
+
+void kdata_tick(void) {
+    write_begin();
+    kdata.ticks = ticks_elapsed();
+    kdata.uptime_ms = ms_elapsed();
+    kdata.tick_tsc = rdtsc();
+    if (kdata.ticks % KDATA_RTC_PERIOD == 0) {
+        read_rtc();
+    }
+    write_end();
+}
+
+void kdata_set_pid(int pid) {
+    if (kdata.pid == (uint32_t)pid) {
+        return;
+    }
+    write_begin();
+    kdata.pid = (uint32_t)pid;
+    write_end();
+}
+
+const kdata_page_t *kdata_page(void) {
+    return &kdata;
+}
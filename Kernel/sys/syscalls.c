@@ -4,8 +4,15 @@
 #include "interrupts.h"
 #include "pipe.h"
 #include "fd.h"
+#include "poll.h"
+#include "futex.h"
 #include "memory_manager.h"
 #include "lib.h"
+#include "infomap.h"
+#include "klog.h"
+#include "serial.h"
+#include "tsc.h"
+#include "errno.h"
 
 #ifndef EINVAL
 #define EINVAL 22
@@ -13,8 +20,10 @@
 
 // Implementación de cada syscall expuesta a userland
 
-// Forward declaration del PIPE_OPS definido en pipe_fd.c
+// Forward declaration de las vtables definidas en pipe_fd.c y sem_fd.c
 extern const struct fd_ops PIPE_OPS;
+extern const struct fd_ops SEM_OPS;
+extern const struct fd_ops SERIAL_OPS;
 
 uint64_t sys_getpid(void) {
     pcb_t *cur = sched_current();
@@ -34,6 +43,33 @@ uint64_t sys_exit(int code) {
     return 0;
 }
 
+// Puntero por proceso para userland (todos comparten el espacio de direcciones,
+// así que las variables globales no sirven para estado propio de cada proceso).
+// El bloque lo asigna el kernel y lo libera cuando el proceso termina, así
+// nunca se libera un puntero que no salió del heap
+void *sys_tls_get(void) {
+    pcb_t *cur = sched_current();
+    return cur != NULL ? cur->user_tls : NULL;
+}
+
+// Asigna size bytes en cero como estado del proceso; reemplaza (y libera)
+// el bloque anterior si lo había
+void *sys_tls_alloc(size_t size, void (*exit_hook)(void)) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL || size == 0) {
+        return NULL;
+    }
+    void *block = mm_malloc(size);
+    if (block == NULL) {
+        return NULL;
+    }
+    memset(block, 0, size);
+    mm_free(cur->user_tls);
+    cur->user_tls = block;
+    cur->exit_hook = exit_hook;
+    return block;
+}
+
 uint64_t sys_nice(int pid, int new_prio) {
     proc_nice(pid, new_prio);
     return 0;
@@ -93,113 +129,22 @@ int sys_mm_get_stats(mm_stats_t *user_stats) {
     return 0;
 }
 
-// Handle con ownership para limpieza automática en proc_exit
-typedef struct sem_handle {
-    ksem_t *sem;
-    int owner_pid;
-} sem_handle_t;
-
-static sem_handle_t sem_handles[KSEM_HANDLE_MAX] = {0}; // Tabla de handles estilo POSIX
-
-// Helpers locales para proteger la tabla de handles
-static uint64_t irq_save_local(void) {
-    uint64_t flags;
-    __asm__ volatile("pushfq\n\tpop %0" : "=r"(flags));
-    _cli();
-    return flags;
-}
-
-static void irq_restore_local(uint64_t flags) {
-    if (flags & (1ULL << 9)) {
-        _sti();
-    }
-}
-
-// Reserva un slot de handle para un semáforo abierto
-static int sem_handle_allocate(ksem_t *sem, int owner_pid) {
-    uint64_t flags = irq_save_local();
-    int allocated_count = 0;
-    for (int i = 0; i < KSEM_HANDLE_MAX; i++) {
-        if (sem_handles[i].sem != NULL) {
-            allocated_count++;
-        }
-        if (sem_handles[i].sem == NULL) {
-            sem_handles[i].sem = sem;
-            sem_handles[i].owner_pid = owner_pid;
-            irq_restore_local(flags);
-            return i + 1;
-        }
-    }
-    // DEBUG: Tabla llena - registrar evento
-    irq_restore_local(flags);
-    extern void ncPrintDec(uint64_t value);
-    extern void ncPrint(const char *string);
-    ncPrint("[KERNEL] Handle table FULL! ");
-    ncPrintDec(allocated_count);
-    ncPrint(" handles allocated\n");
-    return -1;
-}
-
-// Obtiene el puntero asociado sin modificar la tabla
-static ksem_t *sem_handle_peek(int handle) {
-    if (handle <= 0 || handle > KSEM_HANDLE_MAX) {
+// Los handles de semáforo son fds (FD_SEM) de la tabla del proceso
+static ksem_t *sem_from_fd(int fd) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL || cur->fd_table == NULL) {
         return NULL;
     }
-    uint64_t flags = irq_save_local();
-    ksem_t *sem = sem_handles[handle - 1].sem;
-    irq_restore_local(flags);
-    return sem;
-}
-
-// Desasocia el handle en la tabla (ksem_close se encarga del refcount)
-static ksem_t *sem_handle_detach(int handle) {
-    if (handle <= 0 || handle > KSEM_HANDLE_MAX) {
+    file_t *file = fd_table_get(cur->fd_table, fd);
+    if (file == NULL || file->type != FD_SEM) {
         return NULL;
     }
-    uint64_t flags = irq_save_local();
-    ksem_t *sem = sem_handles[handle - 1].sem;
-    if (sem != NULL) {
-        sem_handles[handle - 1].sem = NULL;
-        sem_handles[handle - 1].owner_pid = 0;
-    }
-    irq_restore_local(flags);
-    return sem;
-}
-
-// Limpia todos los handles de semáforos pertenecientes a un proceso
-// Llamado desde proc_exit para evitar leaks
-void sem_cleanup_process_handles(int pid) {
-    extern void ncPrintDec(uint64_t value);
-    extern void ncPrint(const char *string);
-    int cleaned = 0;
-
-    uint64_t flags = irq_save_local();
-    for (int i = 0; i < KSEM_HANDLE_MAX; i++) {
-        if (sem_handles[i].sem != NULL && sem_handles[i].owner_pid == pid) {
-            ksem_t *sem = sem_handles[i].sem;
-            sem_handles[i].sem = NULL;
-            sem_handles[i].owner_pid = 0;
-            cleaned++;
-            // Liberar el lock antes de cerrar (ksem_close puede bloquear/yield)
-            irq_restore_local(flags);
-            ksem_close(sem);
-            flags = irq_save_local();
-        }
-    }
-    irq_restore_local(flags);
-
-    if (cleaned > 0) {
-        ncPrint("[KERNEL] Cleaned ");
-        ncPrintDec(cleaned);
-        ncPrint(" handles for PID ");
-        ncPrintDec(pid);
-        ncPrint("\n");
-    }
+    return (ksem_t *)file->ptr;
 }
 
 int sys_sem_open(const char *name, unsigned int init) {
     pcb_t *cur = sched_current();
-    if (cur == NULL) {
+    if (cur == NULL || cur->fd_table == NULL) {
         return -1;
     }
 
@@ -208,23 +153,21 @@ int sys_sem_open(const char *name, unsigned int init) {
         return -1;
     }
 
-    int handle = sem_handle_allocate(sem, cur->pid);
-    if (handle < 0) {
-        // DEBUG: Tabla de handles llena
-        extern void ncPrintDec(uint64_t value);
-        extern void ncNewline(void);
-        extern void ncPrint(const char *string);
-        ncPrint("[KERNEL] sem_open failed for PID ");
-        ncPrintDec(cur->pid);
-        ncPrint(" - handle table full\n");
+    file_t *file = file_create(FD_SEM, sem, false, false, &SEM_OPS);
+    if (file == NULL) {
         ksem_close(sem);
         return -1;
     }
-    return handle;
+
+    int fd = fd_table_allocate(cur->fd_table, file);
+    if (fd < 0) {
+        file_release(file);  // cierra el semáforo vía SEM_OPS
+    }
+    return fd;
 }
 
 int sys_sem_wait(int sem_id) {
-    ksem_t *sem = sem_handle_peek(sem_id);
+    ksem_t *sem = sem_from_fd(sem_id);
     if (sem == NULL) {
         return -1;
     }
@@ -232,7 +175,7 @@ int sys_sem_wait(int sem_id) {
 }
 
 int sys_sem_post(int sem_id) {
-    ksem_t *sem = sem_handle_peek(sem_id);
+    ksem_t *sem = sem_from_fd(sem_id);
     if (sem == NULL) {
         return -1;
     }
@@ -240,11 +183,10 @@ int sys_sem_post(int sem_id) {
 }
 
 int sys_sem_close(int sem_id) {
-    ksem_t *sem = sem_handle_detach(sem_id);
-    if (sem == NULL) {
+    if (sem_from_fd(sem_id) == NULL) {
         return -1;
     }
-    return ksem_close(sem);
+    return fd_table_close(sched_current()->fd_table, sem_id);
 }
 
 int sys_sem_unlink(const char *name) {
@@ -283,6 +225,33 @@ int sys_pipe_open(const char *name, int flags) {
         kpipe_close(p, for_read, for_write);
         return -1;
     }
+    file->flags = flags & O_NONBLOCK;
+
+    int fd = fd_table_allocate(cur->fd_table, file);
+    if (fd < 0) {
+        file_release(file);
+    }
+    return fd;
+}
+
+// Abre COM1 como fd (mismos flags que sys_pipe_open); falla si no hay UART
+int sys_serial_open(int flags) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL || cur->fd_table == NULL || !serial_present()) {
+        return -1;
+    }
+
+    bool for_read = (flags & 1) != 0;
+    bool for_write = (flags & 2) != 0;
+    if (!for_read && !for_write) {
+        return -1;
+    }
+
+    file_t *file = file_create(FD_SERIAL, NULL, for_read, for_write, &SERIAL_OPS);
+    if (file == NULL) {
+        return -1;
+    }
+    file->flags = flags & O_NONBLOCK;
 
     int fd = fd_table_allocate(cur->fd_table, file);
     if (fd < 0) {
@@ -355,6 +324,107 @@ int sys_write(int fd, const void *buf, int n) {
     return file->ops->write(file, buf, n);
 }
 
+// Copia el vector al stack del kernel (userland no puede cambiarlo a mitad
+// de la operación) y valida que el total entre en un int
+static int iov_import(const iovec_t *uiov, int cnt, iovec_t *kiov) {
+    if (uiov == NULL || cnt <= 0 || cnt > IOV_MAX) {
+        return E_INVAL;
+    }
+
+    uint64_t total = 0;
+    for (int i = 0; i < cnt; i++) {
+        kiov[i] = uiov[i];
+        if (kiov[i].iov_len > 0 && kiov[i].iov_base == NULL) {
+            return E_INVAL;
+        }
+        total += kiov[i].iov_len;
+        if (total > 0x7FFFFFFF) {
+            return E_INVAL;
+        }
+    }
+    return total > 0 ? 0 : E_INVAL;
+}
+
+// Sin readv nativo se lee iovec por iovec hasta una lectura corta
+int sys_readv(int fd, const iovec_t *iov, int cnt) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL || cur->fd_table == NULL) {
+        return -1;
+    }
+    file_t *file = fd_table_get(cur->fd_table, fd);
+    if (file == NULL || file->ops == NULL) {
+        return -1;
+    }
+
+    iovec_t kiov[IOV_MAX];
+    int err = iov_import(iov, cnt, kiov);
+    if (err < 0) {
+        return err;
+    }
+    if (file->ops->readv != NULL) {
+        return file->ops->readv(file, kiov, cnt);
+    }
+    if (file->ops->read == NULL) {
+        return -1;
+    }
+
+    int total = 0;
+    for (int i = 0; i < cnt; i++) {
+        if (kiov[i].iov_len == 0) {
+            continue;
+        }
+        int n = file->ops->read(file, kiov[i].iov_base, (int)kiov[i].iov_len);
+        if (n < 0) {
+            return total > 0 ? total : n;
+        }
+        total += n;
+        if ((uint64_t)n < kiov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
+// Sin writev nativo se escribe iovec por iovec hasta una escritura corta
+int sys_writev(int fd, const iovec_t *iov, int cnt) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL || cur->fd_table == NULL) {
+        return -1;
+    }
+    file_t *file = fd_table_get(cur->fd_table, fd);
+    if (file == NULL || file->ops == NULL) {
+        return -1;
+    }
+
+    iovec_t kiov[IOV_MAX];
+    int err = iov_import(iov, cnt, kiov);
+    if (err < 0) {
+        return err;
+    }
+    if (file->ops->writev != NULL) {
+        return file->ops->writev(file, kiov, cnt);
+    }
+    if (file->ops->write == NULL) {
+        return -1;
+    }
+
+    int total = 0;
+    for (int i = 0; i < cnt; i++) {
+        if (kiov[i].iov_len == 0) {
+            continue;
+        }
+        int n = file->ops->write(file, kiov[i].iov_base, (int)kiov[i].iov_len);
+        if (n < 0) {
+            return total > 0 ? total : n;
+        }
+        total += n;
+        if ((uint64_t)n < kiov[i].iov_len) {
+            break;
+        }
+    }
+    return total;
+}
+
 int sys_close(int fd) {
     pcb_t *cur = sched_current();
     if (cur == NULL || cur->fd_table == NULL) {
@@ -370,3 +440,134 @@ int sys_dup2(int oldfd, int newfd) {
     }
     return fd_table_dup2(cur->fd_table, oldfd, newfd);
 }
+
+int sys_poll(struct pollfd *fds, int n, int timeout_ms) {
+    return kpoll(fds, n, timeout_ms);
+}
+
+// Solo O_NONBLOCK es modificable; el flag es del archivo, no del fd
+int sys_fcntl(int fd, int cmd, int arg) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL || cur->fd_table == NULL) {
+        return -1;
+    }
+    file_t *file = fd_table_get(cur->fd_table, fd);
+    if (file == NULL) {
+        return -1;
+    }
+
+    switch (cmd) {
+    case F_GETFL:
+        return file->flags;
+    case F_SETFL:
+        file->flags = (file->flags & ~O_NONBLOCK) | (arg & O_NONBLOCK);
+        return 0;
+    case F_ISATTY:
+        return file->type == FD_TTY ? 1 : 0;
+    default:
+        return -1;
+    }
+}
+
+// Control específico del dispositivo detrás del fd (p. ej. modo de la TTY)
+int sys_ioctl(int fd, int request, int arg) {
+    pcb_t *cur = sched_current();
+    if (cur == NULL || cur->fd_table == NULL) {
+        return -1;
+    }
+    file_t *file = fd_table_get(cur->fd_table, fd);
+    if (file == NULL || file->ops == NULL || file->ops->ioctl == NULL) {
+        return -1;
+    }
+    return file->ops->ioctl(file, request, arg);
+}
+
+// ========================================
+// Futex
+// ========================================
+int sys_futex_wait(volatile uint32_t *addr, uint32_t expected) {
+    return futex_wait(addr, expected);
+}
+
+int sys_futex_wake(volatile uint32_t *addr, int n) {
+    return futex_wake(addr, n);
+}
+
+// ========================================
+// Benchmark de memcpy/memset/memmove
+// ========================================
+
+// Zona libre e identity-mapped a continuación del back buffer de video
+#define MEM_BENCH_SCRATCH   0x2000000
+#define MEM_BENCH_MAX_SIZE  (1024 * 1024)
+#define MEM_BENCH_MAX_BYTES (64ULL * 1024 * 1024)
+#define MEM_BENCH_CHUNK     (256 * 1024)   // bytes entre puntos de preemption
+
+// Devuelve los ciclos de TSC de iters llamadas a la operación sobre size bytes.
+// MEM_BENCH_FEATURES devuelve los bits MEM_FEAT_* detectados
+uint64_t sys_mem_bench(int op, uint64_t size, uint64_t iters) {
+    if (op == MEM_BENCH_FEATURES) {
+        return memCpuFeatures();
+    }
+    if (size == 0 || size > MEM_BENCH_MAX_SIZE || iters == 0 || size * iters > MEM_BENCH_MAX_BYTES) {
+        return (uint64_t)-1;
+    }
+    // src y dst ocupan dos bloques de MEM_BENCH_MAX_SIZE: tienen que existir en RAM
+    if (infomap_ram_bytes() < MEM_BENCH_SCRATCH + 2 * MEM_BENCH_MAX_SIZE + 64) {
+        return (uint64_t)-1;
+    }
+
+    uint8_t *src = (uint8_t *)MEM_BENCH_SCRATCH;
+    uint8_t *dst = src + MEM_BENCH_MAX_SIZE + 64;  // desalineado a propósito respecto de src
+    memset(src, 0x5A, size);
+
+    // Hasta 64 MiB con IF=0 son decenas de ms sin timer: cada MEM_BENCH_CHUNK
+    // bytes se abre un punto de preemption, que no entra en la medición
+    uint64_t cycles = 0;
+    uint64_t chunk = 0;
+    uint64_t start = rdtsc();
+    for (uint64_t i = 0; i < iters; i++) {
+        chunk += size;
+        if (chunk >= MEM_BENCH_CHUNK) {
+            cycles += rdtsc() - start;
+            sched_preempt_point();
+            chunk = 0;
+            start = rdtsc();
+        }
+        switch (op) {
+        case MEM_BENCH_MEMCPY:
+            memcpy(dst, src, size);
+            break;
+        case MEM_BENCH_MEMSET:
+            memset(dst, (int)i, size);
+            break;
+        case MEM_BENCH_MEMMOVE:
+            memmove(src + 8, src, size);  // solapado: fuerza la copia hacia atrás
+            break;
+        case MEM_BENCH_BYTES:
+            for (uint64_t j = 0; j < size; j++) {
+                dst[j] = src[j];
+            }
+            break;
+        default:
+            return (uint64_t)-1;
+        }
+    }
+    return cycles + (rdtsc() - start);
+}
+
+// ========================================
+// Log del kernel
+// ========================================
+int sys_dmesg(uint64_t *seq, char *buf, int size) {
+    return klog_read(seq, buf, size);
+}
+
+// level < 0 solo consulta; devuelve el umbral anterior
+int sys_klog_level(int level) {
+    int previous = klog_get_level();
+    if (level >= 0) {
+        klog_set_level(level);
+    }
+    return previous;
+}
@@ -1,18 +1,44 @@
 #include <stdint.h>
 #include <time.h>
+#include <videoDriver.h>
+#include <sound.h>
+#include <kdata.h>
+#include <irqoff.h>
+#include <irqtrace.h>
 
-static unsigned long ticks = 0;
+#define PIT_PORT_CH0 0x40
+#define PIT_PORT_CMD 0x43
+
+static uint64_t ticks = 0;
 extern int _hlt();
-int ellapsed = 0; // Used in sleep(), cleared by sleep(), incremented by timer_handler()
+
+static inline void outb(uint16_t port, uint8_t value);
+
+static inline void outb(uint16_t port, uint8_t value) {
+	__asm__ volatile("outb %0, %1" : : "a"(value), "Nd"(port));
+}
 
 // Debug: agregar contador visible
 static int debug_timer_count = 0;
 
+// Cubre timer_handler y schedule: el stub lo cierra después de schedule
+static irqoff_site_t timer_site = IRQOFF_SITE("irq:timer", IRQOFF_IRQ);
+
 void timer_handler() {
+	irqtrace_timer_entry();
+	irqoff_begin(&timer_site);
 	ticks++;
-	ellapsed += 55;  //timer ticks every 55ms (taught in class)
 
-	// Debug cada 100 ticks (~5.5 segundos)
+	// Publicar ticks, uptime y RTC en la página compartida con userland
+	kdata_tick();
+
+	// Publicar en pantalla lo que se dibujó en el back buffer
+	vDriver_tick();
+
+	// Avanzar la melodía encolada, si hay una sonando
+	sound_tick();
+
+	// Debug cada 100 ticks
 	debug_timer_count++;
 	if (debug_timer_count >= 100) {
 		// Este printf debería aparecer si el timer funciona
@@ -21,31 +47,56 @@ void timer_handler() {
 	}
 }
 
-int ticks_elapsed() {
+// Programa el canal 0 del PIT a TICK_HZ. Con el timer del LAPIC activo el
+// IRQ0 queda enmascarado, pero el PIT sigue siendo el respaldo
+void timer_init(void) {
+	uint16_t divisor = (PIT_HZ + TICK_HZ / 2) / TICK_HZ;
+	outb(PIT_PORT_CMD, 0x34);   // canal 0, lo/hi, modo 2
+	outb(PIT_PORT_CH0, divisor & 0xFF);
+	outb(PIT_PORT_CH0, divisor >> 8);
+}
+
+uint64_t ticks_elapsed() {
 	return ticks;
 }
 
+// Convierte milisegundos a ticks redondeando hacia arriba
+uint64_t ms_to_ticks(int ms) {
+	if (ms <= 0) {
+		return 0;
+	}
+	return ((uint64_t)ms * TICK_HZ + 999) / 1000;
+}
+
+uint64_t us_to_ticks(uint64_t us) {
+	return (us * TICK_HZ + 999999) / 1000000;
+}
+
 int seconds_elapsed() {
-	return ticks / 18;
+	return (int)(ticks / TICK_HZ);
 }
 
 void sleep(int millis){
-	ellapsed = 0;
-	while (ellapsed<millis)
+	irqoff_site_t *site = irqoff_pause();
+	uint64_t target = ticks + ms_to_ticks(millis);
+	while (ticks < target)
 	{
 		_hlt();
 	}
+	irqoff_resume(site);
 }
 
-int ms_elapsed() {
-    return ticks*5000/91;
+uint64_t ms_elapsed() {
+    return ticks * 1000 / TICK_HZ;
 }
 
 void timer_wait(int delta) {
-	unsigned long initialTicks = ticks;
-	unsigned long targetDelta = (delta < 0) ? 0UL : (unsigned long)delta;
+	uint64_t initialTicks = ticks;
+	uint64_t targetDelta = (delta < 0) ? 0 : (uint64_t)delta;
 
+	irqoff_site_t *site = irqoff_pause();
 	while ((ticks - initialTicks) < targetDelta) {
 		_hlt();
 	}
+	irqoff_resume(site);
 }
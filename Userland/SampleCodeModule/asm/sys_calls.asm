@@ -1,4 +1,4 @@
-; Trampas ASM que invocan int 0x80 con el número correcto de syscall
+; Trampas ASM que invocan al kernel con el número correcto de syscall
 GLOBAL sys_read
 GLOBAL sys_write
 GLOBAL sys_clear
@@ -46,6 +46,29 @@ GLOBAL sys_write_fd
 GLOBAL sys_close_fd
 GLOBAL sys_dup2
 GLOBAL sys_create_process_ex
+GLOBAL sys_poll
+GLOBAL sys_fcntl
+GLOBAL sys_futex_wait
+GLOBAL sys_futex_wake
+GLOBAL sys_video_batch
+GLOBAL sys_tls_get
+GLOBAL sys_tls_alloc
+GLOBAL sys_mem_bench
+GLOBAL sys_play_melody
+GLOBAL sys_dmesg
+GLOBAL sys_klog_level
+GLOBAL sys_serial_open
+GLOBAL sys_ioctl
+GLOBAL sys_syscall_stats
+GLOBAL sys_nop_syscall
+GLOBAL sys_nop_int80
+GLOBAL sys_kdata
+GLOBAL sys_io_ring_setup
+GLOBAL sys_io_ring_enter
+GLOBAL sys_readv
+GLOBAL sys_writev
+GLOBAL sys_irqoff_stats
+GLOBAL sys_irqlat_stats
 section .text
 
 ; Pasaje de parametros en C:
@@ -60,238 +83,248 @@ section .text
 
 ; %rax el numero de la syscall
 
+; Por defecto se entra con SYSCALL; ensamblando con -DSYSCALL_INT80 todas
+; las trampas vuelven a la compuerta int 0x80, que el kernel mantiene
+%macro SYSCALL_TRAP 0
+%ifdef SYSCALL_INT80
+    int 80h
+%else
+    syscall
+%endif
+%endmacro
+
 sys_read:
     mov rax, 0x00
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_write:
     mov rax, 0x01
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_clear:
     mov rax, 0x02
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_getHours:
     mov rax, 0x03
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_getMinutes:
     mov rax, 0x04
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_getSeconds:
     mov rax, 0x05
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_scrHeight:
     mov rax, 0x06
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_scrWidth:
     mov rax, 0x07
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_drawRectangle:
     mov rax, 0x08
     mov r10, rcx        ;4to parametro de syscall es R10
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_wait:
     mov rax, 0x09
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_registerInfo:
     mov rax, 0x0A
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_printmem: 
     mov rax, 0x0B
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_pixelPlus: 
     mov rax, 0x0C
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_pixelMinus: 
     mov rax, 0x0D
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_playSpeaker: 
     mov rax, 0x0E
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_stopSpeaker: 
     mov rax, 0x0F
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_drawCursor:
     mov rax, 0x10
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_writeColor:
     mov rax, 0x11
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_malloc:
     mov rax, 0x12
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_free:
     mov rax, 0x13
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_mem_info:
     mov rax, 0x14
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_mm_get_stats:
     mov rax, 0x2E
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_getpid:
     mov rax, 0x15
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_create_process:
     mov rax, 0x16
     mov r10, rcx        ;4to parametro de syscall es R10
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_kill:
     mov rax, 0x17
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_block:
     mov rax, 0x18
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_unblock:
     mov rax, 0x19
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_nice:
     mov rax, 0x1A
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_yield:
     mov rax, 0x1B
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_wait_pid:
     mov rax, 0x1C
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_exit:
     mov rax, 0x1D
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_proc_snapshot:
     mov rax, 0x1E
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_sem_open:
     mov rax, 0x1F
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_sem_wait:
     mov rax, 0x20
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_sem_post:
     mov rax, 0x21
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_sem_close:
     mov rax, 0x22
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_sem_unlink:
     mov rax, 0x23
-    int 80h
+    SYSCALL_TRAP
     ret
 
 ; Pipes (Hito 5)
 sys_pipe_open:
     mov rax, 36
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_pipe_close:
     mov rax, 37
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_pipe_read:
     mov rax, 38
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_pipe_write:
     mov rax, 39
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_pipe_unlink:
     mov rax, 40
-    int 80h
+    SYSCALL_TRAP
     ret
 
 ; FD genéricos
 sys_read_fd:
     mov rax, 41
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_write_fd:
     mov rax, 42
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_close_fd:
     mov rax, 43
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_dup2:
     mov rax, 44
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_create_process_ex:
@@ -299,12 +332,127 @@ sys_create_process_ex:
     mov r10, rcx        ; 4to parámetro (name)
     ; r8 ya tiene el 5to parámetro (priority)
     ; r9 ya tiene el 6to parámetro (is_fg)
-    int 80h
+    SYSCALL_TRAP
     ret
 
 sys_wait_children:
     mov rax, 47
     ; rdi ya tiene el parámetro (status)
-    int 80h
+    SYSCALL_TRAP
+    ret
+
+sys_poll:
+    mov rax, 48
+    SYSCALL_TRAP
+    ret
+
+sys_fcntl:
+    mov rax, 49
+    SYSCALL_TRAP
+    ret
+
+sys_futex_wait:
+    mov rax, 50
+    SYSCALL_TRAP
+    ret
+
+sys_futex_wake:
+    mov rax, 51
+    SYSCALL_TRAP
+    ret
+
+sys_video_batch:
+    mov rax, 52
+    SYSCALL_TRAP
+    ret
+
+sys_tls_get:
+    mov rax, 53
+    SYSCALL_TRAP
+    ret
+
+sys_tls_alloc:
+    mov rax, 54
+    SYSCALL_TRAP
+    ret
+
+sys_mem_bench:
+    mov rax, 55
+    SYSCALL_TRAP
+    ret
+
+sys_play_melody:
+    mov rax, 56
+    SYSCALL_TRAP
+    ret
+
+sys_dmesg:
+    mov rax, 57
+    SYSCALL_TRAP
+    ret
+
+sys_klog_level:
+    mov rax, 58
+    SYSCALL_TRAP
     ret
 
+sys_serial_open:
+    mov rax, 59
+    SYSCALL_TRAP
+    ret
+
+sys_ioctl:
+    mov rax, 60
+    SYSCALL_TRAP
+    ret
+
+sys_syscall_stats:
+    mov rax, 61
+    SYSCALL_TRAP
+    ret
+
+sys_kdata:
+    mov rax, 63
+    SYSCALL_TRAP
+    ret
+
+sys_io_ring_setup:
+    mov rax, 64
+    SYSCALL_TRAP
+    ret
+
+sys_io_ring_enter:
+    mov rax, 65
+    SYSCALL_TRAP
+    ret
+
+sys_readv:
+    mov rax, 66
+    SYSCALL_TRAP
+    ret
+
+sys_writev:
+    mov rax, 67
+    SYSCALL_TRAP
+    ret
+
+sys_irqoff_stats:
+    mov rax, 68
+    SYSCALL_TRAP
+    ret
+
+sys_irqlat_stats:
+    mov rax, 69
+    SYSCALL_TRAP
+    ret
+
+; Syscall vacía por cada camino de entrada, para comparar su costo
+sys_nop_syscall:
+    mov rax, 62
+    syscall
+    ret
+
+sys_nop_int80:
+    mov rax, 62
+    int 80h
+    ret
@@ -0,0 +1,16 @@
+#ifndef _KDATA_H_
+#define _KDATA_H_
+
+#include <stdint.h>
+
+// Lecturas sin syscall desde la página que publica el kernel (ver
+// kdata_page.h). La página se pide una sola vez con sys_kdata; después
+// cada consulta son unas pocas lecturas de memoria.
+
+int64_t  kd_getpid(void);
+uint64_t kd_ticks(void);
+uint64_t kd_uptime_ms(void);
+// Hora del RTC (UTC)
+void     kd_time(int *hours, int *minutes, int *seconds);
+
+#endif
@@ -4,9 +4,30 @@
 #include <stdarg.h>
 #include <stddef.h>
 
+// Los streams se identifican por fd; stdout y stderr tienen buffer propio
+// por proceso (el resto de los fds se escriben sin retener datos)
+#define stdout 1
+#define stderr 2
+
+#define _IOFBF 0    // buffer completo: se vacía al llenarse
+#define _IOLBF 1    // por línea: se vacía en cada '\n' (stdout en la TTY)
+#define _IONBF 2    // sin buffer (stderr)
+#define BUFSIZ 512
+
 int printf(const char *format, ...);
+int fprintf(int fd, const char *format, ...);
+int vfprintf(int fd, const char *format, va_list args);
 int sprintf(char *str, const char *format, ...);
+int snprintf(char *str, size_t size, const char *format, ...);
+int vsnprintf(char *str, size_t size, const char *format, va_list args);
 int puts(const char *str);
 int putchar(int c);
+int fputs(const char *str, int fd);
+size_t fwrite(const void *buf, size_t size, size_t count, int fd);
+int fflush(int fd);
+int setvbuf(int fd, int mode);
+
+// Vacía stdout/stderr y termina el proceso (usar en lugar de sys_exit)
+void exit(int code);
 
 #endif
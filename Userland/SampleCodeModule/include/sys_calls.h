@@ -4,6 +4,12 @@
 #include <stdint.h>
 #include <colors.h>
 #include <mm_stats.h>
+#include <syscall_stats.h>
+#include <irqoff_stats.h>
+#include <irqlat_stats.h>
+#include <kdata_page.h>
+#include <io_ring.h>
+#include <uio.h>
 
 // Wrapper de syscalls que el userland expone como librería estándar
 
@@ -51,6 +57,10 @@ uint64_t sys_writeColor(uint64_t fd, char buffer, Color color);
 
 uint64_t sys_clear();
 
+// Agrupa dibujos en un único volcado a pantalla: 1 abre, 0 cierra y vuelca
+// (si no se cierra en ~0.5 s el kernel vuelca igual)
+uint64_t sys_video_batch(int begin);
+
 uint64_t sys_getHours();
 
 uint64_t sys_pixelPlus();
@@ -61,6 +71,11 @@ uint64_t sys_playSpeaker(uint32_t frequence, uint64_t duration);
 
 uint64_t sys_stopSpeaker();
 
+// Encola un arreglo de NoteType y retorna sin esperar a que suene;
+// devuelve cuántas notas aceptó (la cola del kernel tiene 64 lugares).
+// sys_stopSpeaker corta la melodía en curso
+int sys_play_melody(const void *notes, int count);
+
 uint64_t sys_getMinutes();
 
 uint64_t sys_getSeconds();
@@ -103,6 +118,7 @@ int64_t sys_exit(int code);
 
 int64_t sys_proc_snapshot(proc_info_t *buffer, uint64_t max_count);
 
+// El handle devuelto es un fd del proceso (se cierra solo al terminar)
 int64_t sys_sem_open(const char *name, unsigned int init);
 int64_t sys_sem_wait(int sem_id);
 int64_t sys_sem_post(int sem_id);
@@ -110,7 +126,7 @@ int64_t sys_sem_close(int sem_id);
 int64_t sys_sem_unlink(const char *name);
 
 // Pipes (Hito 5)
-int sys_pipe_open(const char *name, int flags);  // flags: 1=R, 2=W, 3=RW
+int sys_pipe_open(const char *name, int flags);  // flags: 1=R, 2=W, 3=RW, |O_NONBLOCK
 int sys_pipe_close(int fd);
 int sys_pipe_read(int fd, void *buf, int n);
 int sys_pipe_write(int fd, const void *buf, int n);
@@ -119,9 +135,108 @@ int sys_pipe_unlink(const char *name);
 // FD genéricos (pueden usar stdin=0, stdout=1, stderr=2)
 int sys_read_fd(int fd, void *buf, int n);
 int sys_write_fd(int fd, const void *buf, int n);
+// Scatter-gather: un solo trap para hasta IOV_MAX buffers. Pipes y TTY
+// lo atienden de una vez; en otros fds equivale a un read/write por iovec
+int sys_readv(int fd, const iovec_t *iov, int cnt);
+int sys_writev(int fd, const iovec_t *iov, int cnt);
 int sys_close_fd(int fd);
+
+// Abre COM1 como fd (flags como sys_pipe_open); -1 si no hay puerto serie
+int sys_serial_open(int flags);
 int sys_dup2(int oldfd, int newfd);
 
+// Multiplexación y flags de fds (deben coincidir con el kernel)
+#define O_NONBLOCK 0x4
+#define F_GETFL    1
+#define F_SETFL    2
+#define F_ISATTY   3
+
+#define POLLIN    0x0001
+#define POLLOUT   0x0004
+#define POLLERR   0x0008
+#define POLLHUP   0x0010
+#define POLLNVAL  0x0020
+#define POLL_MAX_FDS 16
+
+typedef struct {
+    int fd;
+    int16_t events;
+    int16_t revents;
+} pollfd_t;
+
+// timeout_ms < 0 espera indefinidamente, 0 solo consulta. Retorna cuántos fds están listos.
+int sys_poll(pollfd_t *fds, int n, int timeout_ms);
+int sys_fcntl(int fd, int cmd, int arg);
+
+// Disciplina de línea de la TTY: TTY_SETFLAGS con TTY_ICANON | TTY_ECHO
+// (canónico: edición y eco en el kernel, una lectura por línea) o TTY_RAW
+// (cada tecla al instante, sin eco). TTY_GETFLAGS devuelve los flags
+#define TTY_GETFLAGS 1
+#define TTY_SETFLAGS 2
+#define TTY_ICANON   0x1
+#define TTY_ECHO     0x2
+#define TTY_RAW      0
+int sys_ioctl(int fd, int request, int arg);
+
+// Contadores por syscall: SYSCALL_STATS_READ copia hasta max entradas en out
+// y devuelve cuántas; SYSCALL_STATS_RESET los pone en cero
+int sys_syscall_stats(int op, syscall_stat_t *out, int max);
+
+// Tramos con interrupciones deshabilitadas por sitio (syscall o IRQ):
+// IRQOFF_STATS_READ copia hasta max sitios; IRQOFF_STATS_RESET los pone en cero
+int sys_irqoff_stats(int op, irqoff_stat_t *out, int max);
+
+// Traza de tramos _cli/_sti y latencia de los IRQ de timer y teclado:
+// IRQLAT_STATS_READ la copia en out; IRQLAT_STATS_RESET la pone en cero
+int sys_irqlat_stats(int op, irqlat_stats_t *out);
+
+// Syscall vacía forzando cada camino de entrada (SYSCALL o int 0x80)
+uint64_t sys_nop_syscall(void);
+uint64_t sys_nop_int80(void);
+
+// Página de solo lectura con PID, ticks y hora que mantiene el kernel;
+// conviene leerla con los helpers de kdata.h
+const kdata_page_t *sys_kdata(void);
+
+// Ring de envío/completado del proceso (ver io_ring.h y uring.h).
+// setup registra el ring (NULL lo quita); enter procesa hasta to_submit
+// sqes (< 0: todas) y devuelve cuántas consumió
+int sys_io_ring_setup(io_ring_t *ring);
+int sys_io_ring_enter(int to_submit);
+
+// Futex: bloquea si *addr == expected / despierta hasta n procesos en addr.
+// Usar a través de usync.h; solo se invocan cuando hay contención.
+int sys_futex_wait(volatile uint32_t *addr, uint32_t expected);
+int sys_futex_wake(volatile uint32_t *addr, int n);
+
+// Estado propio del proceso (los globales son compartidos por todos).
+// sys_tls_alloc asigna size bytes en cero (reemplazando el bloque anterior)
+// y el kernel los libera al terminar el proceso; no usar free sobre ellos.
+// exit_hook se llama cuando la función de entrada retorna.
+void *sys_tls_get(void);
+void *sys_tls_alloc(uint64_t size, void (*exit_hook)(void));
+
+// Benchmark de memcpy/memset/memmove del kernel: devuelve los ciclos de TSC
+// de iters llamadas sobre size bytes (size <= 1 MB), o -1 si se rechaza
+#define MEM_BENCH_MEMCPY   0
+#define MEM_BENCH_MEMSET   1
+#define MEM_BENCH_MEMMOVE  2
+#define MEM_BENCH_BYTES    3
+#define MEM_BENCH_FEATURES 4   // devuelve los bits MEM_FEAT_*
+#define MEM_FEAT_ERMS 0x1
+#define MEM_FEAT_FSRM 0x2
+uint64_t sys_mem_bench(int op, uint64_t size, uint64_t iters);
+
+// Log del kernel: copia líneas completas desde *seq (empezar en 0) y
+// avanza *seq; devuelve los bytes copiados, 0 cuando no hay más.
+// sys_klog_level fija el umbral (level < 0 solo consulta) y devuelve el anterior
+#define KLOG_ERR   0
+#define KLOG_WARN  1
+#define KLOG_INFO  2
+#define KLOG_DEBUG 3
+int sys_dmesg(uint64_t *seq, char *buf, int size);
+int sys_klog_level(int level);
+
 #define MIN_PRIORITY 0
 #define MAX_PRIORITY 3
 #define DEFAULT_PRIORITY 2
@@ -0,0 +1,24 @@
+#ifndef _URING_H_
+#define _URING_H_
+
+#include <stdint.h>
+#include <io_ring.h>
+
+// Helpers sobre el ring de envío/completado (ver io_ring.h).
+// Uso: uring_queue por operación, uring_submit una vez por lote y
+// uring_peek_cqe/uring_cqe_seen para cosechar los resultados
+
+int  uring_init(io_ring_t *ring, uint32_t entries);
+void uring_destroy(io_ring_t *ring);
+
+// Encola una operación IO_OP_*; -1 si el SQ está lleno
+int uring_queue(io_ring_t *ring, uint8_t op, int fd, const void *buf, uint32_t len, uint64_t user_data);
+
+// Entrega todas las sqes pendientes con un solo trap; devuelve cuántas se procesaron
+int uring_submit(io_ring_t *ring);
+
+// NULL si no hay resultados; uring_cqe_seen libera el slot
+io_cqe_t *uring_peek_cqe(io_ring_t *ring);
+void uring_cqe_seen(io_ring_t *ring);
+
+#endif
@@ -69,13 +69,15 @@ uint64_t charToInt(char *str);
 void printDec(uint64_t value);
 void printHex(uint64_t value);
 void printBin(uint64_t value);
+/* prints value right-aligned in width columns */
+void printDecPadded(uint64_t value, int width);
 void printBase(uint64_t value, uint32_t base);
 void printsColor(const char *str, int lenght, Color color);
 
 int atoi(const char *str);
 
 void triggerSpeaker(uint32_t frequence, uint64_t duration);
-void playMelody(NoteType *melody, int length);
+int playMelody(NoteType *melody, int length);
 
 void clear_scr();
 int get_scrWidth();
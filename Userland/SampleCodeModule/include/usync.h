@@ -0,0 +1,36 @@
+#ifndef _USYNC_H_
+#define _USYNC_H_
+
+#include <stdint.h>
+
+// Primitivas de sincronización en userland sobre sys_futex_*.
+// Sin contención lock/unlock y wait/post son solo operaciones atómicas;
+// el kernel se invoca únicamente para bloquear o despertar.
+// Viven en memoria compartida (todos los procesos comparten el espacio
+// de direcciones), por ejemplo en un static o en un bloque de malloc.
+
+// Mutex: 0 = libre, 1 = tomado, 2 = tomado con procesos esperando
+typedef struct {
+    volatile uint32_t state;
+} umutex_t;
+
+// Semáforo contador: waiters evita el syscall de wake cuando nadie espera
+typedef struct {
+    volatile uint32_t value;
+    volatile uint32_t waiters;
+} usem_t;
+
+#define UMUTEX_INITIALIZER {0}
+#define USEM_INITIALIZER(v) {(v), 0}
+
+void umutex_init(umutex_t *m);
+void umutex_lock(umutex_t *m);
+int  umutex_trylock(umutex_t *m);
+void umutex_unlock(umutex_t *m);
+
+void usem_init(usem_t *s, uint32_t value);
+void usem_wait(usem_t *s);
+int  usem_trywait(usem_t *s);
+void usem_post(usem_t *s);
+
+#endif
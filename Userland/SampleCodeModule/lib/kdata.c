@@ -0,0 +1,81 @@
+#include <kdata.h>
+#include <sys_calls.h>
+
+// Todos los procesos comparten el espacio de direcciones: el puntero
+// cacheado sirve para cualquiera
+static const kdata_page_t *page = 0;
+
+static const kdata_page_t *kd_page(void) {
+    if (page == 0) {
+        page = sys_kdata();
+    }
+    return page;
+}
+
+// seqlock: reintentar si el kernel estaba escribiendo o escribió en el medio
+static uint32_t read_begin(const kdata_page_t *p) {
+    uint32_t seq;
+    while ((seq = __atomic_load_n(&p->seq, __ATOMIC_ACQUIRE)) & 1) {
+    }
+    return seq;
+}
+
+static int read_retry(const kdata_page_t *p, uint32_t seq) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return __atomic_load_n(&p->seq, __ATOMIC_RELAXED) != seq;
+}
+
+int64_t kd_getpid(void) {
+    const kdata_page_t *p = kd_page();
+    uint32_t seq;
+    int64_t pid;
+    do {
+        seq = read_begin(p);
+        pid = p->pid;
+    } while (read_retry(p, seq));
+    return pid;
+}
+
+uint64_t kd_ticks(void) {
+    const kdata_page_t *p = kd_page();
+    uint32_t seq;
+    uint64_t ticks;
+    do {
+        seq = read_begin(p);
+        ticks = p->ticks;
+    } while (read_retry(p, seq));
+    return ticks;
+}
+
+uint64_t kd_uptime_ms(void) {
+    const kdata_page_t *p = kd_page();
+    uint32_t seq;
+    uint64_t ms;
+    do {
+        seq = read_begin(p);
+        ms = p->uptime_ms;
+    } while (read_retry(p, seq));
+    return ms;
+}
+
+void kd_time(int *hours, int *minutes, int *seconds) {
+    const kdata_page_t *p = kd_page();
+    uint32_t seq;
+    int h, m, s;
+    do {
+        seq = read_begin(p);
+        h = p->hours;
+        m = p->minutes;
+        s = p->seconds;
+    } while (read_retry(p, seq));
+
+    if (hours != 0) {
+        *hours = h;
+    }
+    if (minutes != 0) {
+        *minutes = m;
+    }
+    if (seconds != 0) {
+        *seconds = s;
+    }
+}
@@ -1,8 +1,45 @@
 #include <stdio.h>
 #include <sys_calls.h>
+#include <userlib.h>
 #include <stdarg.h>
+#include <stdbool.h>
 #include <stdint.h>
 
+// Streams con buffer para stdout/stderr. Como todos los procesos comparten el
+// espacio de direcciones, el estado no puede ser global: cada proceso lo crea
+// al primer uso con sys_tls_alloc (el kernel lo vacía cuando la función de
+// entrada retorna y lo libera al terminar)
+
+typedef struct {
+    int fd;
+    int mode;       // _IOFBF, _IOLBF o _IONBF
+    int len;
+    char buf[BUFSIZ];
+} stream_t;
+
+typedef struct {
+    stream_t out;
+    stream_t err;
+} stdio_state_t;
+
+// Destino de format(): un stream o un string acotado (snprintf)
+typedef struct {
+    stream_t *stream;
+    char *str;
+    size_t size;
+    size_t len;     // caracteres producidos (aunque no entren en str)
+} sink_t;
+
+static stdio_state_t *stdio_state(void);
+static stream_t *stream_for(int fd);
+static void stream_init(stream_t *s, int fd, int mode);
+static void stream_flush(stream_t *s);
+static void stream_write(stream_t *s, const char *buf, size_t n);
+static void sink_put(sink_t *out, char c);
+static void sink_puts(sink_t *out, const char *str);
+static int format(sink_t *out, const char *fmt, va_list args);
+static void stdio_exit_flush(void);
+
 
 // Funcion auxiliar para convertir entero a string
 static void itoa(int64_t value, char *str, int base) {
@@ -58,169 +95,285 @@ static void utoa(uint64_t value, char *str, int base) {
     }
 }
 
-// Implementacion simple de printf
-int printf(const char *format, ...) {
-    va_list args;
-    va_start(args, format);
-    
-    char buffer[1024];
-    char *ptr = buffer;
-    int count = 0;
-    
-    while (*format) {
-        if (*format == '%') {
-            format++;
-            if (*format == 'd' || *format == 'i') {
-                int val = va_arg(args, int);
-                char num_str[32];
-                itoa(val, num_str, 10);
-                char *s = num_str;
-                while (*s) {
-                    *ptr++ = *s++;
-                    count++;
-                }
-            } else if (*format == 'l' && *(format + 1) == 'd') {
-                // Handle %ld format
-                format++; // Skip the 'l'
-                int64_t val = va_arg(args, int64_t);
-                char num_str[32];
-                itoa(val, num_str, 10);
-                char *s = num_str;
-                while (*s) {
-                    *ptr++ = *s++;
-                    count++;
-                }
-            } else if (*format == 'u') {
-                unsigned int val = va_arg(args, unsigned int);
-                char num_str[32];
-                utoa(val, num_str, 10);
-                char *s = num_str;
-                while (*s) {
-                    *ptr++ = *s++;
-                    count++;
-                }
-            } else if (*format == 'x') {
-                unsigned int val = va_arg(args, unsigned int);
-                char num_str[32];
-                utoa(val, num_str, 16);
-                char *s = num_str;
-                while (*s) {
-                    *ptr++ = *s++;
-                    count++;
-                }
-            } else if (*format == 's') {
-                char *s = va_arg(args, char*);
-                if (s) {
-                    while (*s) {
-                        *ptr++ = *s++;
-                        count++;
-                    }
-                }
-            } else if (*format == 'c') {
-                char c = (char)va_arg(args, int);
-                *ptr++ = c;
-                count++;
-            } else if (*format == '%') {
-                *ptr++ = '%';
-                count++;
+static void stream_init(stream_t *s, int fd, int mode) {
+    s->fd = fd;
+    s->mode = mode;
+    s->len = 0;
+}
+
+// Obtiene (o crea) el estado stdio del proceso actual
+static stdio_state_t *stdio_state(void) {
+    stdio_state_t *st = (stdio_state_t *)sys_tls_get();
+    if (st != NULL) {
+        return st;
+    }
+
+    st = (stdio_state_t *)sys_tls_alloc(sizeof(stdio_state_t), stdio_exit_flush);
+    if (st == NULL) {
+        return NULL;
+    }
+    // Línea a línea en la TTY; en pipes se acumula hasta llenar el buffer
+    stream_init(&st->out, 1, sys_fcntl(1, F_ISATTY, 0) == 1 ? _IOLBF : _IOFBF);
+    stream_init(&st->err, 2, _IONBF);
+    return st;
+}
+
+// stdout y stderr tienen stream; el resto de los fds (o sin memoria) NULL
+static stream_t *stream_for(int fd) {
+    if (fd != stdout && fd != stderr) {
+        return NULL;
+    }
+    stdio_state_t *st = stdio_state();
+    if (st == NULL) {
+        return NULL;
+    }
+    return fd == stdout ? &st->out : &st->err;
+}
+
+static void stream_flush(stream_t *s) {
+    int off = 0;
+    while (off < s->len) {
+        int n = sys_write_fd(s->fd, s->buf + off, s->len - off);
+        if (n <= 0) {
+            break;  // error de escritura: se descarta lo pendiente
+        }
+        off += n;
+    }
+    s->len = 0;
+}
+
+static void stream_write(stream_t *s, const char *buf, size_t n) {
+    bool newline = false;
+    for (size_t i = 0; i < n; i++) {
+        if (s->len == BUFSIZ) {
+            stream_flush(s);
+        }
+        s->buf[s->len++] = buf[i];
+        newline |= (buf[i] == '\n');
+    }
+    if (s->mode == _IONBF || (s->mode == _IOLBF && newline)) {
+        stream_flush(s);
+    }
+}
+
+static void sink_put(sink_t *out, char c) {
+    if (out->stream != NULL) {
+        if (out->stream->len == BUFSIZ) {
+            stream_flush(out->stream);
+        }
+        out->stream->buf[out->stream->len++] = c;
+    } else if (out->len + 1 < out->size) {
+        out->str[out->len] = c;
+    }
+    out->len++;
+}
+
+static void sink_puts(sink_t *out, const char *str) {
+    while (*str) {
+        sink_put(out, *str++);
+    }
+}
+
+// Formatos soportados: %d %i %u %x (con prefijo l opcional), %s, %c y %%
+static int format(sink_t *out, const char *fmt, va_list args) {
+    char num_str[32];
+
+    while (*fmt) {
+        if (*fmt != '%') {
+            sink_put(out, *fmt++);
+            continue;
+        }
+        fmt++;
+        bool is_long = false;
+        if (*fmt == 'l') {
+            is_long = true;
+            fmt++;
+        }
+
+        switch (*fmt) {
+        case 'd':
+        case 'i':
+            itoa(is_long ? va_arg(args, int64_t) : va_arg(args, int), num_str, 10);
+            sink_puts(out, num_str);
+            break;
+        case 'u':
+            utoa(is_long ? va_arg(args, uint64_t) : va_arg(args, unsigned int), num_str, 10);
+            sink_puts(out, num_str);
+            break;
+        case 'x':
+            utoa(is_long ? va_arg(args, uint64_t) : va_arg(args, unsigned int), num_str, 16);
+            sink_puts(out, num_str);
+            break;
+        case 's': {
+            const char *str = va_arg(args, const char *);
+            if (str) {
+                sink_puts(out, str);
             }
-            format++;
-        } else {
-            *ptr++ = *format++;
-            count++;
+            break;
         }
-        
-        // Vaciar buffer si se esta llenando
-        if (ptr - buffer > 1000) {
-            sys_write_fd(1, buffer, ptr - buffer);
-            ptr = buffer;
+        case 'c':
+            sink_put(out, (char)va_arg(args, int));
+            break;
+        case '%':
+            sink_put(out, '%');
+            break;
+        case '\0':
+            return (int)out->len;
+        default:
+            break;
         }
+        fmt++;
     }
-    
-    // Vaciar el buffer restante
-    if (ptr > buffer) {
-        sys_write_fd(1, buffer, ptr - buffer);
+    return (int)out->len;
+}
+
+int vfprintf(int fd, const char *format_str, va_list args) {
+    stream_t *s = stream_for(fd);
+    stream_t tmp;
+    if (s == NULL) {
+        // fd sin stream propio: buffer temporal en el stack, sin retener datos
+        stream_init(&tmp, fd, _IONBF);
+        s = &tmp;
     }
-    
+
+    sink_t out = {s, NULL, 0, 0};
+    int count = format(&out, format_str, args);
+
+    // Mismas reglas que stream_write, aplicadas una vez al final
+    if (s->mode == _IONBF) {
+        stream_flush(s);
+    } else if (s->mode == _IOLBF) {
+        for (int i = 0; i < s->len; i++) {
+            if (s->buf[i] == '\n') {
+                stream_flush(s);
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+int fprintf(int fd, const char *format_str, ...) {
+    va_list args;
+    va_start(args, format_str);
+    int count = vfprintf(fd, format_str, args);
     va_end(args);
     return count;
 }
 
-int sprintf(char *str, const char *format, ...) {
+int printf(const char *format_str, ...) {
     va_list args;
-    va_start(args, format);
-    
-    char *ptr = str;
-    int count = 0;
-    
-    while (*format) {
-        if (*format == '%') {
-            format++;
-            if (*format == 'd' || *format == 'i') {
-                int val = va_arg(args, int);
-                char num_str[32];
-                itoa(val, num_str, 10);
-                char *s = num_str;
-                while (*s) {
-                    *ptr++ = *s++;
-                    count++;
-                }
-            } else if (*format == 'l' && *(format + 1) == 'd') {
-                // Handle %ld format
-                format++; // Skip the 'l'
-                int64_t val = va_arg(args, int64_t);
-                char num_str[32];
-                itoa(val, num_str, 10);
-                char *s = num_str;
-                while (*s) {
-                    *ptr++ = *s++;
-                    count++;
-                }
-            } else if (*format == 's') {
-                char *s = va_arg(args, char*);
-                if (s) {
-                    while (*s) {
-                        *ptr++ = *s++;
-                        count++;
-                    }
-                }
-            } else if (*format == 'c') {
-                char c = (char)va_arg(args, int);
-                *ptr++ = c;
-                count++;
-            }
-            format++;
-        } else {
-            *ptr++ = *format++;
-            count++;
-        }
+    va_start(args, format_str);
+    int count = vfprintf(stdout, format_str, args);
+    va_end(args);
+    return count;
+}
+
+// Escribe como mucho size-1 caracteres más el '\0'; retorna la longitud completa
+int vsnprintf(char *str, size_t size, const char *format_str, va_list args) {
+    sink_t out = {NULL, str, size, 0};
+    int count = format(&out, format_str, args);
+    if (size > 0) {
+        str[out.len < size ? out.len : size - 1] = '\0';
     }
-    
-    *ptr = '\0';
+    return count;
+}
+
+int snprintf(char *str, size_t size, const char *format_str, ...) {
+    va_list args;
+    va_start(args, format_str);
+    int count = vsnprintf(str, size, format_str, args);
     va_end(args);
     return count;
 }
 
-// Implementación de puts - escribe string + newline a stdout
-int puts(const char *str) {
+// Sin límite de tamaño (como el sprintf estándar)
+int sprintf(char *str, const char *format_str, ...) {
+    va_list args;
+    va_start(args, format_str);
+    int count = vsnprintf(str, (size_t)-1 >> 1, format_str, args);
+    va_end(args);
+    return count;
+}
+
+size_t fwrite(const void *buf, size_t size, size_t count, int fd) {
+    size_t total = size * count;
+    if (buf == NULL || total == 0) {
+        return 0;
+    }
+    stream_t *s = stream_for(fd);
+    if (s == NULL) {
+        int n = sys_write_fd(fd, buf, (int)total);
+        return n > 0 ? (size_t)n / size : 0;
+    }
+    stream_write(s, (const char *)buf, total);
+    return count;
+}
+
+int fputs(const char *str, int fd) {
     if (str == NULL) {
         return -1;
     }
-    
-    int len = 0;
-    const char *s = str;
-    while (*s++) {
+    size_t len = 0;
+    while (str[len]) {
         len++;
     }
-    
-    sys_write_fd(1, str, len);
-    sys_write_fd(1, "\n", 1);
+    fwrite(str, 1, len, fd);
+    return (int)len;
+}
+
+// Implementación de puts - escribe string + newline a stdout
+int puts(const char *str) {
+    if (str == NULL) {
+        return -1;
+    }
+    int len = fputs(str, stdout);
+    fwrite("\n", 1, 1, stdout);
     return len + 1;
 }
 
 // Implementación de putchar - escribe un carácter a stdout
 int putchar(int c) {
     char ch = (char)c;
-    sys_write_fd(1, &ch, 1);
+    fwrite(&ch, 1, 1, stdout);
     return (unsigned char)c;
 }
+
+int fflush(int fd) {
+    stream_t *s = stream_for(fd);
+    if (s == NULL) {
+        return fd >= 0 ? 0 : -1;
+    }
+    stream_flush(s);
+    return 0;
+}
+
+// El buffer es interno: solo se puede cambiar el modo (vacía lo pendiente)
+int setvbuf(int fd, int mode) {
+    if (mode != _IOFBF && mode != _IOLBF && mode != _IONBF) {
+        return -1;
+    }
+    stream_t *s = stream_for(fd);
+    if (s == NULL) {
+        return -1;
+    }
+    stream_flush(s);
+    s->mode = mode;
+    return 0;
+}
+
+static void stdio_exit_flush(void) {
+    stdio_state_t *st = (stdio_state_t *)sys_tls_get();
+    if (st != NULL) {
+        stream_flush(&st->out);
+        stream_flush(&st->err);
+    }
+}
+
+// Termina el proceso vaciando antes los buffers de stdio
+void exit(int code) {
+    stdio_exit_flush();
+    sys_exit(code);
+    while (1) {
+    }
+}
@@ -0,0 +1,55 @@
+#include <uring.h>
+#include <sys_calls.h>
+#include <userlib.h>
+
+int uring_init(io_ring_t *ring, uint32_t entries) {
+    ring->entries = entries;
+    ring->sqes = malloc(sizeof(io_sqe_t) * entries);
+    ring->cqes = malloc(sizeof(io_cqe_t) * entries);
+    if (ring->sqes == 0 || ring->cqes == 0 || sys_io_ring_setup(ring) < 0) {
+        uring_destroy(ring);
+        return -1;
+    }
+    return 0;
+}
+
+void uring_destroy(io_ring_t *ring) {
+    sys_io_ring_setup(0);
+    free(ring->sqes);
+    free(ring->cqes);
+    ring->sqes = 0;
+    ring->cqes = 0;
+}
+
+int uring_queue(io_ring_t *ring, uint8_t op, int fd, const void *buf, uint32_t len, uint64_t user_data) {
+    uint32_t tail = ring->sq_tail;
+    if (tail - __atomic_load_n(&ring->sq_head, __ATOMIC_ACQUIRE) >= ring->entries) {
+        return -1;
+    }
+
+    io_sqe_t *sqe = &ring->sqes[tail & (ring->entries - 1)];
+    sqe->op = op;
+    sqe->fd = fd;
+    sqe->addr = (uint64_t)buf;
+    sqe->len = len;
+    sqe->user_data = user_data;
+    __atomic_store_n(&ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+int uring_submit(io_ring_t *ring) {
+    (void)ring;  // el kernel ya conoce el ring registrado del proceso
+    return sys_io_ring_enter(-1);
+}
+
+io_cqe_t *uring_peek_cqe(io_ring_t *ring) {
+    uint32_t head = ring->cq_head;
+    if (head == __atomic_load_n(&ring->cq_tail, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    return &ring->cqes[head & (ring->entries - 1)];
+}
+
+void uring_cqe_seen(io_ring_t *ring) {
+    __atomic_store_n(&ring->cq_head, ring->cq_head + 1, __ATOMIC_RELEASE);
+}
@@ -33,32 +33,64 @@ int scr_height;
 int scr_width;
 
 static uint32_t uintToBase(uint64_t value, char *buffer, uint32_t base);
+static int colorPrefix(char *dst, Color color);
+
+#define COLOR_PREFIX_MAX 20          // "\x1b[38;2;255;255;255m"
+static const char colorReset[] = "\x1b[39m";
 
 void triggerSpeaker(uint32_t frequence, uint64_t duration)
 {
 	sys_playSpeaker(frequence, duration);
 }
 
-void playMelody(NoteType *melody, int length)
+// La melodía se encola en el kernel y suena en segundo plano mientras el
+// proceso sigue corriendo. Retorna cuántas notas entraron en la cola
+int playMelody(NoteType *melody, int length)
 {
-	for (int i = 0; i < length; i++)
-	{
-		triggerSpeaker(melody[i].tone, melody[i].duration);
-	}
+	return sys_play_melody(melody, length);
 }
 
+// La salida de texto pasa por el stream stdout (ver stdio.c)
 void printc(char c)
 {
-	sys_write_fd(STDOUT, &c, 1);
+	putchar(c);
 }
 
+// Secuencia ANSI de color verdadero que entiende la TTY del kernel
+static int colorPrefix(char *dst, Color color)
+{
+	const uint8_t channels[3] = {color.r, color.g, color.b};
+	int len = 0;
+	const char *head = "\x1b[38;2";
+	while (*head)
+	{
+		dst[len++] = *head++;
+	}
+	for (int i = 0; i < 3; i++)
+	{
+		dst[len++] = ';';
+		len += uintToBase(channels[i], dst + len, 10);
+	}
+	dst[len++] = 'm';
+	return len;
+}
+
+// El color viaja con el texto: una sola escritura por carácter
 void printcColor(char c, Color color)
 {
-	sys_writeColor(STDOUT, c, color);
+	char seq[COLOR_PREFIX_MAX + 1 + sizeof(colorReset)];
+	int len = colorPrefix(seq, color);
+	seq[len++] = c;
+	for (int i = 0; colorReset[i] != 0; i++)
+	{
+		seq[len++] = colorReset[i];
+	}
+	fwrite(seq, 1, len, stdout);
 }
 
 void drawCursor()
 {
+	fflush(stdout);  // el cursor va donde terminó el texto ya escrito
 	sys_drawCursor();
 }
 
@@ -70,23 +102,33 @@ void prints(const char *str, int lenght)
 		len++;
 	}
 	
-	// Escribir todo de una vez usando sys_write_fd
 	if (len > 0) {
-		sys_write_fd(STDOUT, str, len);
+		fwrite(str, 1, len, stdout);
 	}
 }
 
 void printsColor(const char *str, int lenght, Color color)
 {
-	for (int i = 0; i < lenght && str[i] != 0; i++)
+	int len = 0;
+	while (len < lenght && str[len] != 0)
+	{
+		len++;
+	}
+	if (len == 0)
 	{
-		printcColor(str[i], color);
+		return;
 	}
+
+	char seq[COLOR_PREFIX_MAX];
+	fwrite(seq, 1, colorPrefix(seq, color), stdout);
+	fwrite(str, 1, len, stdout);
+	fwrite(colorReset, 1, sizeof(colorReset) - 1, stdout);
 }
 
 char getChar()
 {
 	char c;
+	fflush(stdout);  // lo pendiente tiene que verse antes de bloquear leyendo
 	sys_read(0, &c);
 	return c;
 }
@@ -235,6 +277,21 @@ void printBin(uint64_t value)
 	printBase(value, (uint32_t)2);
 }
 
+// printf no soporta ancho de campo: alinea a derecha con espacios
+void printDecPadded(uint64_t value, int width)
+{
+	char digits[24];
+	int len = (int)uintToBase(value, digits, 10);
+	for (int i = len; i < width; i++)
+	{
+		printc(' ');
+	}
+	for (int i = 0; i < len; i++)
+	{
+		printc(digits[i]);
+	}
+}
+
 static uint32_t uintToBase(uint64_t value, char *buffer, uint32_t base)
 {
 	char *p = buffer;
@@ -268,6 +325,7 @@ static uint32_t uintToBase(uint64_t value, char *buffer, uint32_t base)
 
 void clear_scr()
 {
+	fflush(stdout);
 	sys_clear();
 }
 
@@ -0,0 +1,78 @@
+#include <stdbool.h>
+#include <usync.h>
+#include <sys_calls.h>
+
+// Mutex de tres estados (Drepper, "Futexes Are Tricky") y semáforo contador.
+// Todas las operaciones atómicas son seq_cst: el orden entre el valor y el
+// contador de waiters es lo que evita perder un wake.
+
+static uint32_t cas_val(volatile uint32_t *p, uint32_t expected, uint32_t desired) {
+    __atomic_compare_exchange_n(p, &expected, desired, false,
+                                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return expected;  // valor previo
+}
+
+void umutex_init(umutex_t *m) {
+    __atomic_store_n(&m->state, 0, __ATOMIC_SEQ_CST);
+}
+
+void umutex_lock(umutex_t *m) {
+    uint32_t c = cas_val(&m->state, 0, 1);
+    if (c == 0) {
+        return;  // fast path: sin contención
+    }
+
+    // Marcar como contendido antes de dormir para que unlock haga el wake
+    if (c != 2) {
+        c = __atomic_exchange_n(&m->state, 2, __ATOMIC_SEQ_CST);
+    }
+    while (c != 0) {
+        sys_futex_wait(&m->state, 2);
+        c = __atomic_exchange_n(&m->state, 2, __ATOMIC_SEQ_CST);
+    }
+}
+
+int umutex_trylock(umutex_t *m) {
+    return cas_val(&m->state, 0, 1) == 0 ? 0 : -1;
+}
+
+void umutex_unlock(umutex_t *m) {
+    if (__atomic_fetch_sub(&m->state, 1, __ATOMIC_SEQ_CST) != 1) {
+        // Había esperando (estado 2): liberar y despertar a uno
+        __atomic_store_n(&m->state, 0, __ATOMIC_SEQ_CST);
+        sys_futex_wake(&m->state, 1);
+    }
+}
+
+void usem_init(usem_t *s, uint32_t value) {
+    __atomic_store_n(&s->value, value, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&s->waiters, 0, __ATOMIC_SEQ_CST);
+}
+
+int usem_trywait(usem_t *s) {
+    uint32_t v = __atomic_load_n(&s->value, __ATOMIC_SEQ_CST);
+    while (v > 0) {
+        if (__atomic_compare_exchange_n(&s->value, &v, v - 1, false,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) {
+            return 0;
+        }
+    }
+    return -1;
+}
+
+void usem_wait(usem_t *s) {
+    while (usem_trywait(s) != 0) {
+        // El kernel re-chequea value == 0 con el lock del bucket tomado:
+        // si un post llegó entre medio, futex_wait retorna sin bloquear
+        __atomic_fetch_add(&s->waiters, 1, __ATOMIC_SEQ_CST);
+        sys_futex_wait(&s->value, 0);
+        __atomic_fetch_sub(&s->waiters, 1, __ATOMIC_SEQ_CST);
+    }
+}
+
+void usem_post(usem_t *s) {
+    __atomic_fetch_add(&s->value, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&s->waiters, __ATOMIC_SEQ_CST) > 0) {
+        sys_futex_wake(&s->value, 1);
+    }
+}
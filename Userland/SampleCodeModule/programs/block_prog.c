@@ -21,7 +21,7 @@ void block_main(int argc, char **argv) {
 	if (argc < 2) {
 		printf("\nUsage: block <pid>\n");
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Parsear el PID del proceso a bloquear/desbloquear
@@ -29,7 +29,7 @@ void block_main(int argc, char **argv) {
 	if (!parse_int_token(argv[1], &target_pid) || target_pid <= 0) {
 		printf("\nblock: invalid pid '%s'\n", argv[1]);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Si se recibió PID de la shell, evitar bloquearla
@@ -41,7 +41,7 @@ void block_main(int argc, char **argv) {
 	if (target_pid == shell_pid) {
 		printf("\nblock: refusing to block the current shell\n");
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Obtener snapshot de todos los procesos del sistema
@@ -50,7 +50,7 @@ void block_main(int argc, char **argv) {
 	if (count <= 0) {
 		printf("\nblock: could not read process list\n");
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Buscar el proceso objetivo en la lista
@@ -58,14 +58,14 @@ void block_main(int argc, char **argv) {
 	if (target == NULL) {
 		printf("\nblock: pid %d not found\n", target_pid);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// No se puede bloquear un proceso que ya terminó
 	if (target->state == 4) {
 		printf("\nblock: process already exited\n");
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Si está bloqueado (estado 3), desbloquearlo
@@ -73,28 +73,28 @@ void block_main(int argc, char **argv) {
 		if (sys_unblock(target_pid) < 0) {
 			printf("\nblock: failed to unblock process %d\n", target_pid);
 			free_spawn_args(argv, argc);
-			sys_exit(1);
+			exit(1);
 		}
 		printf("\nProcess %d moved to READY\n", target_pid);
 		free_spawn_args(argv, argc);
-		sys_exit(0);
+		exit(0);
 	}
 
 	// No se puede bloquear un proceso que no empezó
 	if (target->state == 0) {
 		printf("\nblock: process not started yet\n");
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Si está en otro estado (READY o RUNNING), bloquearlo
 	if (sys_block(target_pid) < 0) {
 		printf("\nblock: failed to block process %d\n", target_pid);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	printf("\nProcess %d moved to BLOCKED\n", target_pid);
 	free_spawn_args(argv, argc);
-	sys_exit(0);
+	exit(0);
 }
@@ -0,0 +1,56 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <sys_calls.h>
+#include <userlib.h>
+#include <spawn_args.h>
+#include <parse_utils.h>
+
+#define DMESG_CHUNK 512
+
+static const char *level_names[] = {"err", "warn", "info", "debug"};
+
+// Vuelca el log del kernel por stdout, en bloques de líneas completas
+static void dump_log(void) {
+	char buf[DMESG_CHUNK];
+	uint64_t seq = 0;
+	int n;
+
+	while ((n = sys_dmesg(&seq, buf, sizeof(buf))) > 0) {
+		fwrite(buf, 1, n, stdout);
+	}
+}
+
+// Comando dmesg: muestra el log del kernel
+// Uso: dmesg [-l <0-3>]  (-l cambia el umbral: 0=err 1=warn 2=info 3=debug)
+static int dmesg_command(int argc, char **argv) {
+	if (argc == 1) {
+		dump_log();
+		return 0;
+	}
+
+	if (strcmp(argv[1], "-l") != 0 || argc > 3) {
+		printf("\nUsage: dmesg [-l <0-3>]\n");
+		return 1;
+	}
+
+	int previous = sys_klog_level(-1);
+	if (argc == 2) {
+		printf("\ndmesg: level %d (%s)\n", previous, level_names[previous]);
+		return 0;
+	}
+
+	int level = 0;
+	if (!parse_int_token(argv[2], &level) || level < KLOG_ERR || level > KLOG_DEBUG) {
+		printf("\ndmesg: invalid level '%s' (0-3)\n", argv[2]);
+		return 1;
+	}
+	sys_klog_level(level);
+	printf("\ndmesg: level %s -> %s\n", level_names[previous], level_names[level]);
+	return 0;
+}
+
+void dmesg_main(int argc, char **argv) {
+	int status = dmesg_command(argc, argv);
+	free_spawn_args(argv, argc);
+	exit(status);
+}
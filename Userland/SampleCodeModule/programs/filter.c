@@ -26,11 +26,11 @@ void filter_main(int argc, char **argv) {
                 out[j++] = buf[i];
             }
         }
-        // Escribir el resultado filtrado a stdout
+        // Escribir el resultado filtrado a stdout (con buffer)
         if (j > 0) {
-            sys_write_fd(1, out, j);
+            fwrite(out, 1, (size_t)j, stdout);
         }
     }
     free_spawn_args(argv, argc);
-    sys_exit(0);
+    exit(0);
 }
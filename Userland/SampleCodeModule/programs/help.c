@@ -23,14 +23,21 @@ static void print_help_text(void) {
 	printf("\n>waitpid <pid|-1>   - wait for a child to finish");
 	printf("\n>echo <text>        - print text to stdout");
 	printf("\n>mem [-v]           - show memory usage statistics");
+	printf("\n>membench           - benchmark kernel memcpy/memset/memmove");
+	printf("\n>sysbench           - null syscall cost: int 0x80 vs SYSCALL");
+	printf("\n>dmesg [-l <0-3>]   - show kernel log / set its verbosity");
+	printf("\n>syscount [-v|-r]   - per-syscall call counts and cycles");
+	printf("\n>irqoff [-r]        - longest interrupts-off section per site");
+	printf("\n>irqlat [-r]        - longest cli/sti sections and IRQ latency");
 	printf("\n>cat                - read from stdin and write to stdout");
 	printf("\n>wc                 - count lines from stdin");
 	printf("\n>filter             - remove vowels from stdin");
+	printf("\n>serial             - send stdin to the serial port (COM1)");
 	printf("\n>test_mm [size]     - test memory manager (default: 100000000)");
 	printf("\n>test_processes [n] - test process management (default: 10)");
 	printf("\n>test_priority [n]  - scheduling demo (default: 5)");
 	printf("\n>test_no_synchro [n]- run race condition without semaphores");
-	printf("\n>test_synchro [n]   - run synchronized version using semaphores");
+	printf("\n>test_synchro [n] [m]- synchronized (m: 1 semaphore, 2 futex mutex)");
 	printf("\n>mvar <writers> <readers> - start colored MVar demo");
 	printf("\n>exit               - exit KERNEL OS\n\n");
 	printf("Background execution:\n");
@@ -39,7 +46,8 @@ static void print_help_text(void) {
 	printf("  echo hola | wc         - count lines in 'hola'\n");
 	printf("  echo \"hola mundo\" | wc  - count lines with spaces\n");
 	printf("  echo abracadabra | filter - remove vowels\n");
-	printf("  cat | filter           - read input and filter vowels\n\n");
+	printf("  cat | filter           - read input and filter vowels\n");
+	printf("  membench | serial      - export results over COM1\n\n");
 }
 
 // Función principal del comando help
@@ -48,5 +56,5 @@ void help_main(int argc, char **argv) {
 	(void)argc;
 	print_help_text();
 	free_spawn_args(argv, argc);
-	sys_exit(0);
+	exit(0);
 }
@@ -0,0 +1,82 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <sys_calls.h>
+#include <userlib.h>
+#include <spawn_args.h>
+
+// Buckets no vacíos como "<2^k>:n"; el último acumula todo lo mayor
+static void print_latency(const char *title, const irqlat_hist_t *h) {
+	printf("\n %s: %lu samples", title, h->count);
+	if (h->count == 0) {
+		printf("\n");
+		return;
+	}
+	printf(", avg %lu, max %lu cycles\n      ", h->total_cycles / h->count, h->max_cycles);
+	for (int b = 0; b < IRQLAT_HIST_BUCKETS; b++) {
+		if (h->hist[b] == 0) {
+			continue;
+		}
+		if (b == IRQLAT_HIST_BUCKETS - 1) {
+			printf(" >=2^%d:%u", b + IRQLAT_HIST_SHIFT, h->hist[b]);
+		} else {
+			printf(" <2^%d:%u", b + IRQLAT_HIST_SHIFT + 1, h->hist[b]);
+		}
+	}
+	printf("\n");
+}
+
+static int show_stats(void) {
+	irqlat_stats_t *st = malloc(sizeof(irqlat_stats_t));
+	if (st == NULL) {
+		printf("\nirqlat: out of memory\n");
+		return 1;
+	}
+	if (sys_irqlat_stats(IRQLAT_STATS_READ, st) < 0) {
+		printf("\nirqlat: kernel rejected the request\n");
+		free(st);
+		return 1;
+	}
+
+	printf("\n _cli -> _sti sections: %lu", st->sections);
+	if (st->sections > 0) {
+		printf(", avg %lu cycles", st->total_cycles / st->sections);
+	}
+	printf("\n     cycles  cli at / called from / closed at\n");
+	for (int i = 0; i < IRQLAT_TOP && st->top[i].cycles > 0; i++) {
+		const irqlat_section_t *s = &st->top[i];
+		printDecPadded(s->cycles, 11);
+		printf("  0x%lx / 0x%lx / ", s->cli_ip, s->cli_caller);
+		if (s->sti_ip != 0) {
+			printf("0x%lx\n", s->sti_ip);
+		} else {
+			printf("(blocked)\n");
+		}
+	}
+
+	print_latency("timer IRQ -> schedule()", &st->timer);
+	print_latency("keyboard IRQ -> tty_push_char", &st->keyboard);
+
+	free(st);
+	return 0;
+}
+
+// Comando irqlat: secciones críticas más largas y latencia de IRQ
+// Uso: irqlat [-r]  (-r reinicia la traza)
+static int irqlat_command(int argc, char **argv) {
+	if (argc == 1) {
+		return show_stats();
+	}
+	if (argc == 2 && strcmp(argv[1], "-r") == 0) {
+		sys_irqlat_stats(IRQLAT_STATS_RESET, NULL);
+		printf("\nirqlat: trace reset\n");
+		return 0;
+	}
+	printf("\nUsage: irqlat [-r]\n");
+	return 1;
+}
+
+void irqlat_main(int argc, char **argv) {
+	int status = irqlat_command(argc, argv);
+	free_spawn_args(argv, argc);
+	exit(status);
+}
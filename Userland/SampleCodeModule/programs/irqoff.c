@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <sys_calls.h>
+#include <userlib.h>
+#include <spawn_args.h>
+
+static void print_name(const char *name, int width) {
+	printf(" %s", name);
+	for (int i = strlen(name); i < width; i++) {
+		putchar(' ');
+	}
+}
+
+// Orden descendente por tramo máximo: lo que importa es el peor caso
+static void sort_by_max(irqoff_stat_t *st, int n) {
+	for (int i = 1; i < n; i++) {
+		irqoff_stat_t key = st[i];
+		int j = i - 1;
+		while (j >= 0 && st[j].max_cycles < key.max_cycles) {
+			st[j + 1] = st[j];
+			j--;
+		}
+		st[j + 1] = key;
+	}
+}
+
+static int show_stats(void) {
+	irqoff_stat_t *stats = malloc(sizeof(irqoff_stat_t) * IRQOFF_MAX_SITES);
+	if (stats == NULL) {
+		printf("\nirqoff: out of memory\n");
+		return 1;
+	}
+
+	int n = sys_irqoff_stats(IRQOFF_STATS_READ, stats, IRQOFF_MAX_SITES);
+	if (n < 0) {
+		printf("\nirqoff: kernel rejected the request\n");
+		free(stats);
+		return 1;
+	}
+	sort_by_max(stats, n);
+
+	printf("\n site                  entries  avg cycles  max cycles\n");
+	for (int i = 0; i < n; i++) {
+		const irqoff_stat_t *st = &stats[i];
+		if (st->sections == 0) {
+			continue;
+		}
+		print_name(st->name, 15);
+		printDecPadded(st->count, 11);
+		printDecPadded(st->total_cycles / st->sections, 12);
+		printDecPadded(st->max_cycles, 12);
+		if (st->sections != st->count) {
+			printf("  (%u sections)", (uint32_t)st->sections);
+		}
+		printf("\n");
+	}
+
+	free(stats);
+	return 0;
+}
+
+// Comando irqoff: tramo más largo con interrupciones deshabilitadas por sitio
+// Uso: irqoff [-r]  (-r reinicia los contadores)
+static int irqoff_command(int argc, char **argv) {
+	if (argc == 1) {
+		return show_stats();
+	}
+	if (argc == 2 && strcmp(argv[1], "-r") == 0) {
+		sys_irqoff_stats(IRQOFF_STATS_RESET, NULL, 0);
+		printf("\nirqoff: counters reset\n");
+		return 0;
+	}
+	printf("\nUsage: irqoff [-r]\n");
+	return 1;
+}
+
+void irqoff_main(int argc, char **argv) {
+	int status = irqoff_command(argc, argv);
+	free_spawn_args(argv, argc);
+	exit(status);
+}
@@ -10,7 +10,7 @@ void kill_main(int argc, char **argv) {
 	if (argc < 2) {
 		printf("\nUsage: kill <pid>\n");
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Parsear el PID del proceso a terminar
@@ -18,17 +18,17 @@ void kill_main(int argc, char **argv) {
 	if (!parse_int_token(argv[1], &pid)) {
 		printf("\nkill: invalid pid '%s'\n", argv[1]);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Invocar syscall para terminar el proceso
 	if (sys_kill(pid) < 0) {
 		printf("\nkill: failed to terminate pid %d\n", pid);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	printf("\nKilled pid %d\n", pid);
 	free_spawn_args(argv, argc);
-	sys_exit(0);
+	exit(0);
 }
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <sys_calls.h>
+#include <kdata.h>
 
 // Proceso simple que hace un loop infinito
 // Útil para probar ejecución en background, prioridades y kill
@@ -8,7 +9,7 @@ void loop_main(int argc, char **argv) {
     (void)argc;
     (void)argv;
 
-    int64_t pid = sys_getpid();
+    int64_t pid = kd_getpid();
 
     printf("[loop %d] Starting infinite loop (use kill to stop)\n", (int)pid);
 
@@ -162,5 +162,5 @@ int mem_command(int argc, char **argv) {
 void mem_main(int argc, char **argv) {
     int status = mem_command(argc, argv);
     free_spawn_args(argv, argc);
-    sys_exit(status);
+    exit(status);
 }
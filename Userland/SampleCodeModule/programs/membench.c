@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <sys_calls.h>
+#include <userlib.h>
+#include <spawn_args.h>
+
+// Tamaños medidos: de 8 B a 1 MB
+static const uint64_t bench_sizes[] = {8, 64, 512, 4096, 32768, 262144, 1048576};
+#define BENCH_SIZES_QTY (sizeof(bench_sizes) / sizeof(bench_sizes[0]))
+
+// Bytes totales por medición: los tamaños chicos repiten más veces
+#define BENCH_BYTES_PER_RUN (1024 * 1024)
+#define BENCH_MAX_ITERS     4096
+
+static void print_size(uint64_t size) {
+	if (size >= 1024 * 1024) {
+		printDecPadded(size / (1024 * 1024), 4);
+		putchar('M');
+	} else if (size >= 1024) {
+		printDecPadded(size / 1024, 4);
+		putchar('K');
+	} else {
+		printDecPadded(size, 4);
+		putchar('B');
+	}
+}
+
+// Ciclos promedio por llamada, o 0 si el kernel rechazó la medición
+static uint64_t run_bench(int op, uint64_t size, uint64_t iters) {
+	uint64_t cycles = sys_mem_bench(op, size, iters);
+	if (cycles == (uint64_t)-1) {
+		return 0;
+	}
+	return cycles / iters;
+}
+
+static void run_membench(void) {
+	uint64_t features = sys_mem_bench(MEM_BENCH_FEATURES, 0, 0);
+	printf("\nrep movsb: ERMS %s, FSRM %s\n",
+		(features & MEM_FEAT_ERMS) ? "yes" : "no",
+		(features & MEM_FEAT_FSRM) ? "yes" : "no");
+	printf("cycles per call (TSC)\n");
+	printf(" size       bytes      memcpy      memset     memmove\n");
+
+	for (uint64_t i = 0; i < BENCH_SIZES_QTY; i++) {
+		uint64_t size = bench_sizes[i];
+		uint64_t iters = BENCH_BYTES_PER_RUN / size;
+		if (iters > BENCH_MAX_ITERS) {
+			iters = BENCH_MAX_ITERS;
+		}
+		if (iters == 0) {
+			iters = 1;
+		}
+
+		print_size(size);
+		printDecPadded(run_bench(MEM_BENCH_BYTES, size, iters), 12);
+		printDecPadded(run_bench(MEM_BENCH_MEMCPY, size, iters), 12);
+		printDecPadded(run_bench(MEM_BENCH_MEMSET, size, iters), 12);
+		printDecPadded(run_bench(MEM_BENCH_MEMMOVE, size, iters), 12);
+		printf("\n");
+	}
+}
+
+// Comando membench: mide las rutinas de memoria del kernel
+void membench_main(int argc, char **argv) {
+	run_membench();
+	free_spawn_args(argv, argc);
+	exit(0);
+}
@@ -1,4 +1,4 @@
-// mvar.c - Implementación de MVar (Mutable Variable) con semáforos
+// mvar.c - Implementación de MVar (Mutable Variable) con semáforos de userland
 // Demuestra sincronización entre múltiples writers y readers
 // Los writers escriben letras y los readers las leen en colores
 #include <stdbool.h>
@@ -6,19 +6,19 @@
 #include <stdio.h>
 #include <sys_calls.h>
 #include <userlib.h>
+#include <usync.h>
 #include "mvar.h"
 
 #define MVAR_MAX_INSTANCES 4
 #define NAME_LEN 32
-#define SEM_MAX_NAME 32
 #define MAX_WRITERS 26
 
 typedef struct {
     int in_use;
     int id;
     volatile char value;
-    char sem_empty_name[SEM_MAX_NAME];
-    char sem_full_name[SEM_MAX_NAME];
+    usem_t empty;   // 1 mientras el MVar está vacío
+    usem_t full;    // 1 mientras hay un valor sin leer
 } mvar_context_t;
 
 typedef struct {
@@ -77,7 +77,7 @@ static mvar_context_t *ctx_lookup(int id) {
     return NULL;
 }
 
-// Asigna un nuevo contexto MVar con semáforos empty y full
+// Asigna un nuevo contexto MVar: empty=1 (inicialmente vacío), full=0 (sin valor)
 static mvar_context_t *ctx_allocate(void) {
     for (int i = 0; i < MVAR_MAX_INSTANCES; i++) {
         if (!contexts[i].in_use) {
@@ -85,8 +85,8 @@ static mvar_context_t *ctx_allocate(void) {
             ctx->in_use = 1;
             ctx->id = next_ctx_id++;
             ctx->value = 0;
-            sprintf(ctx->sem_empty_name, "mvar_empty_%d", ctx->id);
-            sprintf(ctx->sem_full_name, "mvar_full_%d", ctx->id);
+            usem_init(&ctx->empty, 1);
+            usem_init(&ctx->full, 0);
             return ctx;
         }
     }
@@ -94,10 +94,10 @@ static mvar_context_t *ctx_allocate(void) {
 }
 
 // Proceso writer: escribe una letra en el MVar repetidamente
-// Usa semáforos para sincronización (espera empty, señala full)
+// Sincroniza con usem: sin contención no entra al kernel (espera empty, señala full)
 static void writer_process(int argc, char **argv) {
     if (argc < 3) {
-        sys_exit(-1);
+        exit(-1);
         return;
     }
 
@@ -111,16 +111,7 @@ static void writer_process(int argc, char **argv) {
 
     mvar_context_t *ctx = ctx_lookup(ctx_id);
     if (ctx == NULL) {
-        sys_exit(-1);
-        return;
-    }
-
-    int sem_empty = sys_sem_open(ctx->sem_empty_name, 1);
-    int sem_full = sys_sem_open(ctx->sem_full_name, 0);
-    if (sem_empty < 0 || sem_full < 0) {
-        if (sem_empty >= 0) sys_sem_close(sem_empty);
-        if (sem_full >= 0) sys_sem_close(sem_full);
-        sys_exit(-1);
+        exit(-1);
         return;
     }
 
@@ -129,17 +120,17 @@ static void writer_process(int argc, char **argv) {
     // Loop infinito: escribir la letra asignada
     while (1) {
         active_random_wait(&rand_state);
-        sys_sem_wait(sem_empty);   // Esperar a que el MVar esté vacío
+        usem_wait(&ctx->empty);     // Esperar a que el MVar esté vacío
         ctx->value = letter;        // Escribir la letra
-        sys_sem_post(sem_full);     // Señalar que hay un valor disponible
+        usem_post(&ctx->full);      // Señalar que hay un valor disponible
     }
 }
 
 // Proceso reader: lee del MVar e imprime en color
-// Usa semáforos para sincronización (espera full, señala empty)
+// Sincroniza con usem (espera full, señala empty)
 static void reader_process(int argc, char **argv) {
     if (argc < 3) {
-        sys_exit(-1);
+        exit(-1);
         return;
     }
 
@@ -153,16 +144,7 @@ static void reader_process(int argc, char **argv) {
 
     mvar_context_t *ctx = ctx_lookup(ctx_id);
     if (ctx == NULL) {
-        sys_exit(-1);
-        return;
-    }
-
-    int sem_empty = sys_sem_open(ctx->sem_empty_name, 1);
-    int sem_full = sys_sem_open(ctx->sem_full_name, 0);
-    if (sem_empty < 0 || sem_full < 0) {
-        if (sem_empty >= 0) sys_sem_close(sem_empty);
-        if (sem_full >= 0) sys_sem_close(sem_full);
-        sys_exit(-1);
+        exit(-1);
         return;
     }
 
@@ -173,10 +155,11 @@ static void reader_process(int argc, char **argv) {
     // Loop infinito: leer e imprimir el valor
     while (1) {
         active_random_wait(&rand_state);
-        sys_sem_wait(sem_full);     // Esperar a que haya un valor
+        usem_wait(&ctx->full);       // Esperar a que haya un valor
         char value = ctx->value;     // Leer el valor
-        sys_sem_post(sem_empty);     // Señalar que el MVar está vacío
+        usem_post(&ctx->empty);      // Señalar que el MVar está vacío
         printcColor(value, color);   // Imprimir en color
+        fflush(stdout);              // sin '\n': vaciar para que se vea ya
         sys_yield();
     }
 }
@@ -196,18 +179,6 @@ int mvar_start(int writer_count, int reader_count, mvar_launch_info_t *out_info)
         return -1;
     }
 
-    // Crear semáforos: empty=1 (inicialmente vacío), full=0 (sin valor)
-    int sem_empty = sys_sem_open(ctx->sem_empty_name, 1);
-    int sem_full = sys_sem_open(ctx->sem_full_name, 0);
-    if (sem_empty < 0 || sem_full < 0) {
-        if (sem_empty >= 0) sys_sem_close(sem_empty);
-        if (sem_full >= 0) sys_sem_close(sem_full);
-        ctx->in_use = 0;
-        return -1;
-    }
-    sys_sem_close(sem_empty);
-    sys_sem_close(sem_full);
-
     if (out_info != NULL) {
         out_info->context_id = ctx->id;
         out_info->writer_count = writer_count;
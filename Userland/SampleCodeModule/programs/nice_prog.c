@@ -11,7 +11,7 @@ void nice_main(int argc, char **argv) {
 	if (argc < 3) {
 		printf("\nUsage: nice <pid> <prio>\n");
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Parsear el PID del proceso
@@ -19,7 +19,7 @@ void nice_main(int argc, char **argv) {
 	if (!parse_int_token(argv[1], &pid)) {
 		printf("\nnice: invalid pid '%s'\n", argv[1]);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Parsear la nueva prioridad
@@ -27,24 +27,24 @@ void nice_main(int argc, char **argv) {
 	if (!parse_int_token(argv[2], &prio)) {
 		printf("\nnice: invalid priority '%s'\n", argv[2]);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Validar que la prioridad esté en el rango permitido
 	if (prio < MIN_PRIORITY || prio > MAX_PRIORITY) {
 		printf("\nnice: priority out of range (%d-%d)\n", MIN_PRIORITY, MAX_PRIORITY);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	// Cambiar la prioridad del proceso
 	if (sys_nice(pid, (uint8_t)prio) < 0) {
 		printf("\nnice: failed to set priority for pid %d\n", pid);
 		free_spawn_args(argv, argc);
-		sys_exit(1);
+		exit(1);
 	}
 
 	printf("\nSet pid %d priority to %d\n", pid, prio);
 	free_spawn_args(argv, argc);
-	sys_exit(0);
+	exit(0);
 }
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <sys_calls.h>
 #include <spawn_args.h>
+#include <userlib.h>
 
 // Convierte el código de estado numérico a su representación en texto
 static const char *state_to_string(int state) {
@@ -30,11 +31,28 @@ static void format_hex64(uint64_t value, char out[17]) {
 	out[16] = '\0';
 }
 
-// Imprime un número de 64 bits en formato hexadecimal
-static void print_hex64(uint64_t value) {
-	char buf[17];
-	format_hex64(value, buf);
-	printf("0x%s", buf);
+// Agrega text a la fila y completa con espacios hasta width columnas
+static int append_col(char *row, int len, const char *text, int width) {
+	int start = len;
+	while (*text) {
+		row[len++] = *text++;
+	}
+	while (len - start < width) {
+		row[len++] = ' ';
+	}
+	return len;
+}
+
+static int append_num(char *row, int len, int value, int width) {
+	char num[16];
+	snprintf(num, sizeof(num), "%d", value);
+	return append_col(row, len, num, width);
+}
+
+static int append_hex(char *row, int len, uint64_t value, int width) {
+	char hex[19] = "0x";
+	format_hex64(value, hex + 2);
+	return append_col(row, len, hex, width);
 }
 
 // Comando ps: Lista todos los procesos del sistema
@@ -46,52 +64,36 @@ void ps_main(int argc, char **argv) {
 	if (count <= 0) {
 		printf("\nNo processes to show\n");
 		free_spawn_args(argv, argc);
-		sys_exit(0);
+		exit(0);
 	}
 
 	// Imprimir encabezado de la tabla
 	printf("\nPID   PRIO STATE  TICKS FG        SP                BP                NAME\n");
+	// Las filas van directo con writev: vaciar antes lo que quedó en stdout
+	fflush(stdout);
 
-	// Imprimir información de cada proceso con alineación correcta
+	// Cada fila es un writev: columnas con ancho fijo, nombre y salto de línea
 	for (int i = 0; i < count; i++) {
-		const char *state = state_to_string(info[i].state);
-		const char *fg = info[i].fg ? "FG" : "BG";
-		
-		// Print PID (width 5, left aligned)
-		printf("%d", info[i].pid);
-		int pid_len = (info[i].pid < 10) ? 1 : (info[i].pid < 100) ? 2 : (info[i].pid < 1000) ? 3 : (info[i].pid < 10000) ? 4 : 5;
-		for (int j = pid_len; j < 6; j++) printf(" ");
-		
-		// Print Priority (width 4, left aligned)
-		printf("%d", info[i].priority);
-		int prio_len = (info[i].priority < 10) ? 1 : (info[i].priority < 100) ? 2 : (info[i].priority < 1000) ? 3 : 4;
-		for (int j = prio_len; j < 5; j++) printf(" ");
-		
-		// Print State (width 6, left aligned)
-		printf("%s", state);
-		int state_len = 0;
-		while (state[state_len]) state_len++;
-		for (int j = state_len; j < 7; j++) printf(" ");
-		
-		// Print Ticks (width 5, left aligned)
-		printf("%d", info[i].ticks_left);
-		int ticks_len = (info[i].ticks_left < 10) ? 1 : (info[i].ticks_left < 100) ? 2 : (info[i].ticks_left < 1000) ? 3 : (info[i].ticks_left < 10000) ? 4 : 5;
-		for (int j = ticks_len; j < 6; j++) printf(" ");
-		
-		// Print FG/BG (width 2, left aligned)
-		printf("%s", fg);
-		for (int j = 2; j < 10; j++) printf(" ");
-		
-		// Print SP and BP
-		print_hex64(info[i].sp);
-		printf(" ");
-		print_hex64(info[i].bp);
-		
-		// Print Name
-		printf(" %s\n", info[i].name[0] ? info[i].name : "(no name)");
+		char row[96];
+		int len = 0;
+		len = append_num(row, len, info[i].pid, 6);
+		len = append_num(row, len, info[i].priority, 5);
+		len = append_col(row, len, state_to_string(info[i].state), 7);
+		len = append_num(row, len, info[i].ticks_left, 6);
+		len = append_col(row, len, info[i].fg ? "FG" : "BG", 10);
+		len = append_hex(row, len, info[i].sp, 19);
+		len = append_hex(row, len, info[i].bp, 19);
+
+		const char *name = info[i].name[0] ? info[i].name : "(no name)";
+		iovec_t iov[3] = {
+			{row, (uint64_t)len},
+			{(void *)name, (uint64_t)strlen(name)},
+			{"\n", 1}
+		};
+		sys_writev(stdout, iov, 3);
 	}
 	printf("\n");  // Extra newline for readability
 
 	free_spawn_args(argv, argc);
-	sys_exit(0);
+	exit(0);
 }
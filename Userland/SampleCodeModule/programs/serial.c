@@ -0,0 +1,28 @@
+// serial.c - Lee de stdin y lo envía por el puerto serie (COM1)
+// Pensado para el final de un pipe: membench | serial
+#include <stdio.h>
+#include <sys_calls.h>
+#include <spawn_args.h>
+
+void serial_main(int argc, char **argv) {
+    char buf[256];
+    int n;
+    int status = 0;
+
+    int fd = sys_serial_open(2);
+    if (fd < 0) {
+        printf("\nserial: no serial port\n");
+        status = 1;
+    } else {
+        while ((n = sys_read_fd(0, buf, (int)sizeof(buf))) > 0) {
+            if (sys_write_fd(fd, buf, n) < 0) {
+                status = 1;
+                break;
+            }
+        }
+        sys_close_fd(fd);
+    }
+
+    free_spawn_args(argv, argc);
+    exit(status);
+}
@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <sys_calls.h>
+#include <spawn_args.h>
+#include <kdata.h>
+#include <uring.h>
+
+// Rondas de llamadas; se reporta la mejor para descartar las que
+// interrumpió el timer
+#define BENCH_ROUNDS 8
+#define BENCH_CALLS  10000
+#define RING_BATCH   16      // divide a BENCH_CALLS: no quedan sqes sueltas
+
+static inline uint64_t rdtsc(void) {
+	uint32_t lo, hi;
+	__asm__ volatile("lfence\n\trdtsc" : "=a"(lo), "=d"(hi) : : "memory");
+	return ((uint64_t)hi << 32) | lo;
+}
+
+static uint64_t getpid_syscall(void) {
+	return (uint64_t)sys_getpid();
+}
+
+static uint64_t getpid_kdata(void) {
+	return (uint64_t)kd_getpid();
+}
+
+static int bench_sem = -1;
+static io_ring_t bench_ring;
+static int ring_queued = 0;
+
+static uint64_t sem_post_syscall(void) {
+	return (uint64_t)sys_sem_post(bench_sem);
+}
+
+// Encola el post y entrega el lote completo con un solo trap
+static uint64_t sem_post_ring(void) {
+	uring_queue(&bench_ring, IO_OP_SEM_POST, bench_sem, 0, 0, 0);
+	if (++ring_queued == RING_BATCH) {
+		uring_submit(&bench_ring);
+		while (uring_peek_cqe(&bench_ring) != 0) {
+			uring_cqe_seen(&bench_ring);
+		}
+		ring_queued = 0;
+	}
+	return 0;
+}
+
+// Ciclos por llamada de la mejor ronda
+static uint64_t bench_path(uint64_t (*nop)(void)) {
+	uint64_t best = (uint64_t)-1;
+
+	for (int r = 0; r < BENCH_ROUNDS; r++) {
+		uint64_t start = rdtsc();
+		for (int i = 0; i < BENCH_CALLS; i++) {
+			nop();
+		}
+		uint64_t cycles = (rdtsc() - start) / BENCH_CALLS;
+		if (cycles < best) {
+			best = cycles;
+		}
+	}
+	return best;
+}
+
+// Comando sysbench: compara el costo de una syscall vacía por int 0x80 y por
+// SYSCALL, getpid por syscall contra la página kdata y sem_post de a uno
+// contra lotes en el ring de envío
+void sysbench_main(int argc, char **argv) {
+	uint64_t int80 = bench_path(sys_nop_int80);
+	uint64_t fast = bench_path(sys_nop_syscall);
+
+	printf("\nnull syscall, cycles per call (TSC, best of %d x %d)\n", BENCH_ROUNDS, BENCH_CALLS);
+	printf("  int 0x80: %lu\n", int80);
+	printf("  syscall:  %lu\n", fast);
+	if (fast > 0 && int80 > fast) {
+		printf("  syscall is %lu.%lux faster\n", int80 / fast, (int80 * 10 / fast) % 10);
+	}
+
+	printf("getpid, cycles per call\n");
+	printf("  syscall:    %lu\n", bench_path(getpid_syscall));
+	printf("  kdata page: %lu\n", bench_path(getpid_kdata));
+
+	bench_sem = (int)sys_sem_open("sysbench", 0);
+	if (bench_sem >= 0 && uring_init(&bench_ring, RING_BATCH) == 0) {
+		printf("sem_post, cycles per op\n");
+		printf("  syscall:        %lu\n", bench_path(sem_post_syscall));
+		printf("  ring (batch %d): %lu\n", RING_BATCH, bench_path(sem_post_ring));
+		uring_destroy(&bench_ring);
+	}
+	if (bench_sem >= 0) {
+		sys_sem_close(bench_sem);
+		sys_sem_unlink("sysbench");
+	}
+
+	free_spawn_args(argv, argc);
+	exit(0);
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <sys_calls.h>
+#include <userlib.h>
+#include <spawn_args.h>
+
+#define SYSCOUNT_MAX 96
+
+static void print_name(const char *name, int width) {
+	printf(" %s", name);
+	for (int i = strlen(name); i < width; i++) {
+		putchar(' ');
+	}
+}
+
+// Buckets no vacíos como "<2^k>:n"; el último acumula todo lo mayor
+static void print_hist(const syscall_stat_t *st) {
+	printf("      ");
+	for (int b = 0; b < SYSCALL_HIST_BUCKETS; b++) {
+		if (st->hist[b] == 0) {
+			continue;
+		}
+		if (b == SYSCALL_HIST_BUCKETS - 1) {
+			printf(" >=2^%d:%u", b + SYSCALL_HIST_SHIFT, st->hist[b]);
+		} else {
+			printf(" <2^%d:%u", b + SYSCALL_HIST_SHIFT + 1, st->hist[b]);
+		}
+	}
+	printf("\n");
+}
+
+// Orden descendente por cantidad de llamadas (inserción: son pocas)
+static void sort_by_count(syscall_stat_t *st, int n) {
+	for (int i = 1; i < n; i++) {
+		syscall_stat_t key = st[i];
+		int j = i - 1;
+		while (j >= 0 && st[j].count < key.count) {
+			st[j + 1] = st[j];
+			j--;
+		}
+		st[j + 1] = key;
+	}
+}
+
+static int show_stats(int verbose) {
+	syscall_stat_t *stats = malloc(sizeof(syscall_stat_t) * SYSCOUNT_MAX);
+	if (stats == NULL) {
+		printf("\nsyscount: out of memory\n");
+		return 1;
+	}
+
+	int n = sys_syscall_stats(SYSCALL_STATS_READ, stats, SYSCOUNT_MAX);
+	if (n < 0) {
+		printf("\nsyscount: kernel rejected the request\n");
+		free(stats);
+		return 1;
+	}
+	sort_by_count(stats, n);
+
+	printf("\n nr name                  calls  avg cycles  max cycles\n");
+	for (int i = 0; i < n && stats[i].count > 0; i++) {
+		const syscall_stat_t *st = &stats[i];
+		uint64_t measured = 0;
+		for (int b = 0; b < SYSCALL_HIST_BUCKETS; b++) {
+			measured += st->hist[b];
+		}
+
+		printDecPadded(st->number, 3);
+		print_name(st->name, 15);
+		printDecPadded(st->count, 11);
+		printDecPadded(measured ? st->cycles / measured : 0, 12);
+		printDecPadded(st->max_cycles, 12);
+		printf("%s\n", (st->flags & SYSCALL_F_BLOCKS) ? "  (blocks)" : "");
+		if (verbose) {
+			print_hist(st);
+		}
+	}
+
+	free(stats);
+	return 0;
+}
+
+// Comando syscount: llamadas y latencia por syscall desde el arranque
+// Uso: syscount [-v | -r]  (-v agrega histogramas, -r reinicia los contadores)
+static int syscount_command(int argc, char **argv) {
+	if (argc == 1) {
+		return show_stats(0);
+	}
+	if (argc == 2 && strcmp(argv[1], "-v") == 0) {
+		return show_stats(1);
+	}
+	if (argc == 2 && strcmp(argv[1], "-r") == 0) {
+		sys_syscall_stats(SYSCALL_STATS_RESET, NULL, 0);
+		printf("\nsyscount: counters reset\n");
+		return 0;
+	}
+	printf("\nUsage: syscount [-v | -r]\n");
+	return 1;
+}
+
+void syscount_main(int argc, char **argv) {
+	int status = syscount_command(argc, argv);
+	free_spawn_args(argv, argc);
+	exit(status);
+}
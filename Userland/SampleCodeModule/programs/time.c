@@ -1,24 +1,30 @@
 #include <sys_calls.h>
 #include <userlib.h>
+#include <kdata.h>
 
 #define GMT_OFFSET 3  // Offset para ajustar zona horaria
 
-// Obtiene las horas del RTC (Real Time Clock)
+// Horas, minutos y segundos del RTC (Real Time Clock), leídos de la
+// página que publica el kernel en vez de una syscall por campo
 int getHours()
 {
-	return sys_getHours();
+	int hours;
+	kd_time(&hours, 0, 0);
+	return hours;
 }
 
-// Obtiene los minutos del RTC
 int getMinutes()
 {
-	return sys_getMinutes();
+	int minutes;
+	kd_time(0, &minutes, 0);
+	return minutes;
 }
 
-// Obtiene los segundos del RTC
 int getSeconds()
 {
-	return sys_getSeconds();
+	int seconds;
+	kd_time(0, 0, &seconds);
+	return seconds;
 }
 
 // Imprime la hora actual en formato HH:MM:SS
@@ -27,9 +33,7 @@ void getTime()
 {
 	int hours, minutes, seconds;
 
-	hours = getHours();
-	minutes = getMinutes();
-	seconds = getSeconds();
+	kd_time(&hours, &minutes, &seconds);
 
 	printc('\n');
 	printDec(hours - GMT_OFFSET);  // Ajustar por zona horaria
@@ -25,5 +25,5 @@ void wc_main(int argc, char **argv) {
     printf("%d\n", lines);
 
     free_spawn_args(argv, argc);
-    sys_exit(0);
+    exit(0);
 }
@@ -33,6 +33,13 @@ void nice_main(int argc, char **argv);
 void kill_main(int argc, char **argv);
 void block_main(int argc, char **argv);
 void mem_main(int argc, char **argv);
+void membench_main(int argc, char **argv);
+void sysbench_main(int argc, char **argv);
+void dmesg_main(int argc, char **argv);
+void syscount_main(int argc, char **argv);
+void irqoff_main(int argc, char **argv);
+void irqlat_main(int argc, char **argv);
+void serial_main(int argc, char **argv);
 
 #define SHELL_STDIN 0
 #define SHELL_STDOUT 1
@@ -46,6 +53,7 @@ static void sanitize_echo_text(const char *src, char *dst, int max_len);
 static int parse_command_line(const char *input, char *out_cmd, char *out_param);
 static void echo_output(const char *param, int interactive);
 static int run_pipeline_command(const char *cmd, const char *param);
+static void run_with_param(const char *param, void (*cmd_fn)(void));
 static int has_pipe(char *str);
 static void execute_pipe(char *left_line, char *right_line);
 
@@ -255,7 +263,7 @@ void test_mm_process(int argc, char **argv) {
 	printf("[test_mm_process] Calling test_mm...\n");
 	uint64_t result = test_mm(1, args);
 	printf("[test_mm_process] Finished with result: %d\n", (int)result);
-	sys_exit((int)result);
+	exit((int)result);
 }
 
 void test_processes_process(int argc, char **argv) {
@@ -272,7 +280,7 @@ void test_processes_process(int argc, char **argv) {
 	printf("[test_processes_process] Calling test_processes...\n");
 	test_processes(1, args);
 	printf("[test_processes_process] Finished\n");
-	sys_exit(0);
+	exit(0);
 }
 
 void test_priority_process(int argc, char **argv) {
@@ -289,7 +297,7 @@ void test_priority_process(int argc, char **argv) {
 	printf("[test_priority_process] Calling test_prio...\n");
 	test_prio(1, args);
 	printf("[test_priority_process] Finished\n");
-	sys_exit(0);
+	exit(0);
 }
 
 void test_sync_process(int argc, char **argv) {
@@ -308,7 +316,7 @@ void test_sync_process(int argc, char **argv) {
 	printf("[test_sync_process] Calling test_sync...\n");
 	test_sync(2, args);
 	printf("[test_sync_process] Finished\n");
-	sys_exit(0);
+	exit(0);
 }
 
 void test_no_synchro_process(int argc, char **argv) {
@@ -325,7 +333,7 @@ void test_no_synchro_process(int argc, char **argv) {
 	printf("[test_no_synchro_process] Calling test_no_synchro...\n");
 	test_no_synchro(2, args);
 	printf("[test_no_synchro_process] Finished\n");
-	sys_exit(0);
+	exit(0);
 }
 
 void test_synchro_process(int argc, char **argv) {
@@ -344,7 +352,7 @@ void test_synchro_process(int argc, char **argv) {
 	printf("[test_synchro_process] Calling test_synchro...\n");
 	test_synchro(2, args);
 	printf("[test_synchro_process] Finished\n");
-	sys_exit(0);
+	exit(0);
 }
 
 // Wrapper processes for commands (must be in sh.c for proper linkage)
@@ -352,55 +360,97 @@ static void ps_process(int argc, char **argv) {
 	DBG_MSG("ps_process wrapper start");
 	ps_main(argc, argv);
 	// ps_main calls sys_exit, but just in case:
-	sys_exit(0);
+	exit(0);
 }
 
 static void help_process(int argc, char **argv) {
 	DBG_MSG("help_process wrapper start");
 	help_main(argc, argv);
-	sys_exit(0);
+	exit(0);
 }
 
 static void nice_process(int argc, char **argv) {
 	DBG_MSG("nice_process wrapper start");
 	nice_main(argc, argv);
-	sys_exit(0);
+	exit(0);
 }
 
 static void kill_process(int argc, char **argv) {
 	DBG_MSG("kill_process wrapper start");
 	kill_main(argc, argv);
-	sys_exit(0);
+	exit(0);
 }
 
 static void block_process(int argc, char **argv) {
 	DBG_MSG("block_process wrapper start");
 	block_main(argc, argv);
-	sys_exit(0);
+	exit(0);
 }
 
 static void mem_process(int argc, char **argv) {
 	DBG_MSG("mem_process wrapper start");
 	mem_main(argc, argv);
-	sys_exit(0);
+	exit(0);
+}
+
+static void membench_process(int argc, char **argv) {
+	DBG_MSG("membench_process wrapper start");
+	membench_main(argc, argv);
+	exit(0);
+}
+
+static void sysbench_process(int argc, char **argv) {
+	DBG_MSG("sysbench_process wrapper start");
+	sysbench_main(argc, argv);
+	exit(0);
+}
+
+static void dmesg_process(int argc, char **argv) {
+	DBG_MSG("dmesg_process wrapper start");
+	dmesg_main(argc, argv);
+	exit(0);
+}
+
+static void syscount_process(int argc, char **argv) {
+	DBG_MSG("syscount_process wrapper start");
+	syscount_main(argc, argv);
+	exit(0);
+}
+
+static void irqoff_process(int argc, char **argv) {
+	DBG_MSG("irqoff_process wrapper start");
+	irqoff_main(argc, argv);
+	exit(0);
+}
+
+static void irqlat_process(int argc, char **argv) {
+	DBG_MSG("irqlat_process wrapper start");
+	irqlat_main(argc, argv);
+	exit(0);
+}
+
+static void serial_process(int argc, char **argv) {
+	DBG_MSG("serial_process wrapper start");
+	serial_main(argc, argv);
+	exit(0);
 }
 
 static void cat_process(int argc, char **argv) {
 	DBG_MSG("cat_process wrapper start");
 	cat_main(argc, argv);
-	sys_exit(0);
+	exit(0);
 }
 
 static void wc_process(int argc, char **argv) {
 	DBG_MSG("wc_process wrapper start");
 	wc_main(argc, argv);
-	sys_exit(0);
+	exit(0);
 }
 
 static void filter_process(int argc, char **argv) {
 	DBG_MSG("filter_process wrapper start");
 	filter_main(argc, argv);
-	sys_exit(0);
+	exit(0);
 }
 
 // initialize all to 0
@@ -451,6 +501,13 @@ void cmd_cat(void);
 void cmd_wc(void);
 void cmd_filter(void);
 void cmd_mem(void);
+void cmd_membench(void);
+void cmd_sysbench(void);
+void cmd_dmesg(void);
+void cmd_serial(void);
+void cmd_syscount(void);
+void cmd_irqoff(void);
+void cmd_irqlat(void);
 void cmd_echo(void);
 void cmd_mvar(void);
 void printPrompt(void);
@@ -477,14 +534,21 @@ void printHelp()
 	printf("\n>waitpid <pid|-1>   - wait for a child to finish");
 	printf("\n>echo <text>        - print text to stdout");
 	printf("\n>mem [-v]           - show memory usage statistics");
+	printf("\n>membench           - benchmark kernel memcpy/memset/memmove");
+	printf("\n>sysbench           - null syscall cost: int 0x80 vs SYSCALL");
+	printf("\n>dmesg [-l <0-3>]   - show kernel log / set its verbosity");
+	printf("\n>syscount [-v|-r]   - per-syscall call counts and cycles");
+	printf("\n>irqoff [-r]        - longest interrupts-off section per site");
+	printf("\n>irqlat [-r]        - longest cli/sti sections and IRQ latency");
 	printf("\n>cat                - read from stdin and write to stdout");
 	printf("\n>wc                 - count lines from stdin");
 	printf("\n>filter             - remove vowels from stdin");
+	printf("\n>serial             - send stdin to the serial port (COM1)");
 	printf("\n>test_mm [size]     - test memory manager (default: 100000000)");
 	printf("\n>test_processes [n] - test process management (default: 10)");
 	printf("\n>test_priority [n]  - scheduling demo (default: 5)");
 	printf("\n>test_no_synchro [n]- run race condition without semaphores");
-	printf("\n>test_synchro [n]   - run synchronized version using semaphores");
+	printf("\n>test_synchro [n] [m]- synchronized (m: 1 semaphore, 2 futex mutex)");
 	printf("\n>mvar <writers> <readers> - start colored MVar demo");
 	printf("\n>exit               - exit KERNEL OS");
 	printf("\n\n");
@@ -494,11 +558,12 @@ void printHelp()
 	printf("  echo hola | wc         - count lines in 'hola'\n");
 	printf("  echo \"hola mundo\" | wc  - count lines with spaces\n");
 	printf("  echo abracadabra | filter - remove vowels\n");
-	printf("  cat | filter           - read input and filter vowels\n\n");
+	printf("  cat | filter           - read input and filter vowels\n");
+	printf("  membench | serial      - export results over COM1\n\n");
 }
 
-const char *commands[] = {"undefined", "help", "ls", "time", "clear", "registersinfo", "zerodiv", "invopcode", "exit", "ascii", "test_mm", "test_processes", "test_priority", "test_sync", "test_no_synchro", "test_synchro", "debug", "ps", "loop", "nice", "kill", "block", "yield", "waitpid", "mem", "cat", "wc", "filter", "echo", "mvar"};
-static void (*commands_ptr[MAX_ARGS])() = {
+const char *commands[] = {"undefined", "help", "ls", "time", "clear", "registersinfo", "zerodiv", "invopcode", "exit", "ascii", "test_mm", "test_processes", "test_priority", "test_sync", "test_no_synchro", "test_synchro", "debug", "ps", "loop", "nice", "kill", "block", "yield", "waitpid", "mem", "cat", "wc", "filter", "echo", "mvar", "membench", "dmesg", "serial", "syscount", "sysbench", "irqoff", "irqlat"};
+static void (*commands_ptr[])() = {
 	cmd_undefined,
 	cmd_help,
 	cmd_help,
@@ -528,13 +593,24 @@ static void (*commands_ptr[MAX_ARGS])() = {
 	cmd_wc,
 	cmd_filter,
 	cmd_echo,
-	cmd_mvar
+	cmd_mvar,
+	cmd_membench,
+	cmd_dmesg,
+	cmd_serial,
+	cmd_syscount,
+	cmd_sysbench,
+	cmd_irqoff,
+	cmd_irqlat
 };
 
 // Bucle principal de la shell: lee caracteres y procesa líneas completas
 void sh_loop()
 {
 	char c;
+	// La shell intercala su salida con la de los hijos que lanza: sin buffer
+	setvbuf(stdout, _IONBF);
+	// El historial y (+)/(-) necesitan cada tecla: la shell edita su línea en raw
+	sys_ioctl(SHELL_STDIN, TTY_SETFLAGS, TTY_RAW);
 	printPrompt();
 
 	while (1 && !terminate)
@@ -567,7 +643,10 @@ void printLine(char c)
 	}
 	else if (c == NEW_LINE)
 	{
+		// Los comandos en foreground leen líneas que edita el kernel
+		sys_ioctl(SHELL_STDIN, TTY_SETFLAGS, TTY_ICANON | TTY_ECHO);
 		newLine();
+		sys_ioctl(SHELL_STDIN, TTY_SETFLAGS, TTY_RAW);
 	}
 }
 
@@ -679,6 +758,24 @@ static int has_pipe(char *str) {
 	return -1;
 }
 
+// Corre cmd_fn con param como parámetro global y después restaura el anterior
+static void run_with_param(const char *param, void (*cmd_fn)(void)) {
+	char saved_param[MAX_BUFF + 1];
+	for (int i = 0; i <= MAX_BUFF; i++) {
+		saved_param[i] = parameter[i];
+	}
+	for (int i = 0; i <= MAX_BUFF && param[i] != 0; i++) {
+		parameter[i] = param[i];
+	}
+	if (param[0] == 0) {
+		parameter[0] = 0;
+	}
+	cmd_fn();
+	for (int i = 0; i <= MAX_BUFF; i++) {
+		parameter[i] = saved_param[i];
+	}
+}
+
 // Ejecuta la implementación real de cada comando soportado en pipelines
 static int run_pipeline_command(const char *cmd, const char *param) {
 	if (cmd == NULL || cmd[0] == 0) {
@@ -697,6 +794,10 @@ static int run_pipeline_command(const char *cmd, const char *param) {
 		return spawn_pipeline_process("filter", filter_process, NULL, 0);
 	}
 
+	if (strcmp(cmd, "serial") == 0) {
+		return spawn_pipeline_process("serial", serial_process, NULL, 0);
+	}
+
 	if (strcmp(cmd, "echo") == 0) {
 		echo_output(param, 0);
 		return 0;
@@ -754,6 +855,36 @@ static int run_pipeline_command(const char *cmd, const char *param) {
 		return 0;
 	}
 
+	if (strcmp(cmd, "membench") == 0) {
+		cmd_membench();
+		return 0;
+	}
+
+	if (strcmp(cmd, "sysbench") == 0) {
+		cmd_sysbench();
+		return 0;
+	}
+
+	if (strcmp(cmd, "dmesg") == 0) {
+		run_with_param(param, cmd_dmesg);
+		return 0;
+	}
+
+	if (strcmp(cmd, "syscount") == 0) {
+		run_with_param(param, cmd_syscount);
+		return 0;
+	}
+
+	if (strcmp(cmd, "irqoff") == 0) {
+		run_with_param(param, cmd_irqoff);
+		return 0;
+	}
+
+	if (strcmp(cmd, "irqlat") == 0) {
+		run_with_param(param, cmd_irqlat);
+		return 0;
+	}
+
 	if (strcmp(cmd, "mvar") == 0) {
 		char saved_param[MAX_BUFF + 1];
 		for (int i = 0; i <= MAX_BUFF; i++) {
@@ -1917,6 +2048,164 @@ void cmd_mem()
 	}
 }
 
+void cmd_membench()
+{
+	int argc_spawn = 0;
+	char **argv_spawn = build_spawn_argv("membench", NULL, 0, &argc_spawn);
+	if (argv_spawn == NULL) {
+		printsColor("\nmembench: failed to allocate args\n", MAX_BUFF, RED);
+		return;
+	}
+
+	if (spawn_user_command(membench_process, argc_spawn, argv_spawn, "membench") < 0) {
+		printsColor("\nmembench: failed to spawn process\n", MAX_BUFF, RED);
+	}
+}
+
+void cmd_sysbench()
+{
+	int argc_spawn = 0;
+	char **argv_spawn = build_spawn_argv("sysbench", NULL, 0, &argc_spawn);
+	if (argv_spawn == NULL) {
+		printsColor("\nsysbench: failed to allocate args\n", MAX_BUFF, RED);
+		return;
+	}
+
+	if (spawn_user_command(sysbench_process, argc_spawn, argv_spawn, "sysbench") < 0) {
+		printsColor("\nsysbench: failed to spawn process\n", MAX_BUFF, RED);
+	}
+}
+
+void cmd_dmesg()
+{
+	int idx = 0;
+	char flag_token[MAX_BUFF];
+	char level_token[MAX_BUFF];
+	char extra[MAX_BUFF];
+	const char *args[2];
+	int arg_count = 0;
+
+	if (next_token(parameter, &idx, flag_token, sizeof(flag_token))) {
+		args[arg_count++] = flag_token;
+		if (next_token(parameter, &idx, level_token, sizeof(level_token))) {
+			args[arg_count++] = level_token;
+		}
+		if (next_token(parameter, &idx, extra, sizeof(extra))) {
+			printsColor("\ndmesg: too many arguments\n", MAX_BUFF, RED);
+			return;
+		}
+	}
+
+	int argc_spawn = 0;
+	char **argv_spawn = build_spawn_argv("dmesg", arg_count > 0 ? args : NULL, arg_count, &argc_spawn);
+	if (argv_spawn == NULL) {
+		printsColor("\ndmesg: failed to allocate args\n", MAX_BUFF, RED);
+		return;
+	}
+
+	if (spawn_user_command(dmesg_process, argc_spawn, argv_spawn, "dmesg") < 0) {
+		printsColor("\ndmesg: failed to spawn process\n", MAX_BUFF, RED);
+	}
+}
+
+void cmd_serial()
+{
+	int argc_spawn = 0;
+	char **argv_spawn = build_spawn_argv("serial", NULL, 0, &argc_spawn);
+	if (argv_spawn == NULL) {
+		printsColor("\nserial: failed to allocate args\n", MAX_BUFF, RED);
+		return;
+	}
+
+	if (spawn_user_command(serial_process, argc_spawn, argv_spawn, "serial") < 0) {
+		printsColor("\nserial: failed to spawn process\n", MAX_BUFF, RED);
+	}
+}
+
+void cmd_syscount()
+{
+	int idx = 0;
+	char flag_token[MAX_BUFF];
+	char extra[MAX_BUFF];
+	const char *args[1];
+	int arg_count = 0;
+
+	if (next_token(parameter, &idx, flag_token, sizeof(flag_token))) {
+		args[arg_count++] = flag_token;
+		if (next_token(parameter, &idx, extra, sizeof(extra))) {
+			printsColor("\nsyscount: too many arguments\n", MAX_BUFF, RED);
+			return;
+		}
+	}
+
+	int argc_spawn = 0;
+	char **argv_spawn = build_spawn_argv("syscount", arg_count > 0 ? args : NULL, arg_count, &argc_spawn);
+	if (argv_spawn == NULL) {
+		printsColor("\nsyscount: failed to allocate args\n", MAX_BUFF, RED);
+		return;
+	}
+
+	if (spawn_user_command(syscount_process, argc_spawn, argv_spawn, "syscount") < 0) {
+		printsColor("\nsyscount: failed to spawn process\n", MAX_BUFF, RED);
+	}
+}
+
+void cmd_irqoff()
+{
+	int idx = 0;
+	char flag_token[MAX_BUFF];
+	char extra[MAX_BUFF];
+	const char *args[1];
+	int arg_count = 0;
+
+	if (next_token(parameter, &idx, flag_token, sizeof(flag_token))) {
+		args[arg_count++] = flag_token;
+		if (next_token(parameter, &idx, extra, sizeof(extra))) {
+			printsColor("\nirqoff: too many arguments\n", MAX_BUFF, RED);
+			return;
+		}
+	}
+
+	int argc_spawn = 0;
+	char **argv_spawn = build_spawn_argv("irqoff", arg_count > 0 ? args : NULL, arg_count, &argc_spawn);
+	if (argv_spawn == NULL) {
+		printsColor("\nirqoff: failed to allocate args\n", MAX_BUFF, RED);
+		return;
+	}
+
+	if (spawn_user_command(irqoff_process, argc_spawn, argv_spawn, "irqoff") < 0) {
+		printsColor("\nirqoff: failed to spawn process\n", MAX_BUFF, RED);
+	}
+}
+
+void cmd_irqlat()
+{
+	int idx = 0;
+	char flag_token[MAX_BUFF];
+	char extra[MAX_BUFF];
+	const char *args[1];
+	int arg_count = 0;
+
+	if (next_token(parameter, &idx, flag_token, sizeof(flag_token))) {
+		args[arg_count++] = flag_token;
+		if (next_token(parameter, &idx, extra, sizeof(extra))) {
+			printsColor("\nirqlat: too many arguments\n", MAX_BUFF, RED);
+			return;
+		}
+	}
+
+	int argc_spawn = 0;
+	char **argv_spawn = build_spawn_argv("irqlat", arg_count > 0 ? args : NULL, arg_count, &argc_spawn);
+	if (argv_spawn == NULL) {
+		printsColor("\nirqlat: failed to allocate args\n", MAX_BUFF, RED);
+		return;
+	}
+
+	if (spawn_user_command(irqlat_process, argc_spawn, argv_spawn, "irqlat") < 0) {
+		printsColor("\nirqlat: failed to spawn process\n", MAX_BUFF, RED);
+	}
+}
+
 void cmd_cat()
 {
 	int argc_spawn = 0;
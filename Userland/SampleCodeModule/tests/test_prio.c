@@ -87,7 +87,7 @@ static void print_progress(const char *proc_id, uint64_t counter, uint64_t limit
 void endless_pid(int argc, char **argv) {
 	if (argc < 2) {
 		printf("[test_prio] Invalid arguments for worker process\n");
-		sys_exit(1);
+		exit(1);
 	}
 
 	const char *proc_id = argv[0];
@@ -116,7 +116,7 @@ void endless_pid(int argc, char **argv) {
 	}
 
 	printf("[test_prio] Process %s reached target %s\n", proc_id, argv[1]);
-	sys_exit(0);
+	exit(0);
 }
 
 uint64_t test_prio(uint64_t argc, char *argv[]) {
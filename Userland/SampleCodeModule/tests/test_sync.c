@@ -2,11 +2,18 @@
 #include <stdio.h>
 #include "syscall.h"
 #include "test_util.h"
+#include <usync.h>
 
 #define SEM_ID "sem"
 #define TOTAL_PAIR_PROCESSES 2
 
+// Valores de use_sem
+#define SYNC_NONE   0
+#define SYNC_SEM    1   // semáforo del kernel
+#define SYNC_UMUTEX 2   // mutex de userland sobre futex (usync.h)
+
 int64_t global; // shared memory
+static umutex_t global_mutex = UMUTEX_INITIALIZER;
 
 void slowInc(int64_t *p, int64_t inc) {
   uint64_t aux = *p;
@@ -40,7 +47,7 @@ uint64_t my_process_inc(uint64_t argc, char *argv[]) {
   int pid = (int)my_getpid();
   uint32_t rng = (uint32_t)(pid * 1103515245u + 12345u);
 
-  if (use_sem) {
+  if (use_sem == SYNC_SEM) {
     int h = my_sem_open(SEM_ID, 1);
     if (h < 0) {
       printf("test_sync: ERROR opening semaphore\n");
@@ -59,14 +66,18 @@ uint64_t my_process_inc(uint64_t argc, char *argv[]) {
         my_yield();
       }
     }
-    if (use_sem)
+    if (use_sem == SYNC_SEM)
       my_sem_wait(SEM_ID);
+    else if (use_sem == SYNC_UMUTEX)
+      umutex_lock(&global_mutex);
     slowInc(&global, inc);
-    if (use_sem)
+    if (use_sem == SYNC_SEM)
       my_sem_post(SEM_ID);
+    else if (use_sem == SYNC_UMUTEX)
+      umutex_unlock(&global_mutex);
   }
 
-  if (use_sem)
+  if (use_sem == SYNC_SEM)
     my_sem_close(SEM_ID);
 
   return 0;
@@ -82,6 +93,7 @@ uint64_t test_sync(uint64_t argc, char *argv[]) { //{n, use_sem, 0}
   char *argvInc[] = {argv[0], "1", argv[1], NULL};
 
   global = 0;
+  umutex_init(&global_mutex);
 
   uint64_t i;
   for (i = 0; i < TOTAL_PAIR_PROCESSES; i++) {
@@ -95,6 +107,8 @@ uint64_t test_sync(uint64_t argc, char *argv[]) { //{n, use_sem, 0}
   }
 
   printf("Final value: %ld\n", global);
+  if (satoi(argv[1]) != SYNC_NONE && global != 0)
+    printf("test_sync: ERROR expected 0\n");
 
   return 0;
 }
@@ -0,0 +1,30 @@
+#ifndef IRQOFF_STATS_H
+#define IRQOFF_STATS_H
+
+#include <stdint.h>
+
+// Tramos con interrupciones deshabilitadas por sitio, exportados por
+// sys_irqoff_stats
+
+#define IRQOFF_NAME_MAX  16
+#define IRQOFF_MAX_SITES 96
+
+// Tipo de sitio
+#define IRQOFF_SYSCALL  0   // cuerpo de una syscall (corre con IF=0)
+#define IRQOFF_IRQ      1   // handler de interrupción
+
+// op de sys_irqoff_stats
+#define IRQOFF_STATS_READ   0
+#define IRQOFF_STATS_RESET  1
+
+typedef struct irqoff_stat {
+    char     name[IRQOFF_NAME_MAX];
+    uint32_t kind;
+    uint32_t reserved;
+    uint64_t count;         // veces que se entró al sitio
+    uint64_t sections;      // tramos medidos (un sitio se corta al bloquear o en un punto de preemption)
+    uint64_t total_cycles;
+    uint64_t max_cycles;    // tramo más largo sin que el timer pudiera entrar
+} irqoff_stat_t;
+
+#endif /* IRQOFF_STATS_H */
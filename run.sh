@@ -11,6 +11,9 @@ if [[ "$1" = "gdb" ]]; then
     echo "Starting in debug mode..."
     echo "Connect with: gdb -> target remote localhost:1234"
     qemu-system-x86_64 -s -S -hda Image/x64BareBonesImage.qcow2 -m 512
+elif [[ "$1" = "serial" ]]; then
+    # COM1 (log del kernel y lo que se mande con el comando serial) sale por esta terminal
+    qemu-system-x86_64 -hda Image/x64BareBonesImage.qcow2 -m 512 -serial stdio
 else
     qemu-system-x86_64 -hda Image/x64BareBonesImage.qcow2 -m 512
 fi 